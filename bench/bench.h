@@ -0,0 +1,41 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <string>
+
+// A minimal benchmark registry, built and run by 'make bench'. BENCH(name) defines a case that
+// bench_main.cc runs; a case times its own loop with a Stopwatch and prints what it measured
+// with report. Build with the release flags, the numbers mean nothing at -O0.
+
+struct BenchRegistrar
+{
+    BenchRegistrar(const char *name, void (*run)());
+};
+
+// prints what took seconds / count each, in a unit that suits it
+void report(const std::string &what, double seconds, long count);
+// prints how many things per second count of them in seconds is, for throughput
+void reportRate(const std::string &what, double seconds, long count, const std::string &things);
+
+class Stopwatch
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+public:
+    double seconds() const { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+};
+
+// keeps the compiler from dropping work whose result nothing else reads
+template <typename T>
+inline void keep(const T &value)
+{
+    asm volatile("" : : "m"(value) : "memory");
+}
+
+#define BENCH(name)                                           \
+    static void name();                                       \
+    static BenchRegistrar name##Registrar(#name, name);       \
+    static void name()
+
+#endif // BENCH_H
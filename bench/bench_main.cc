@@ -0,0 +1,73 @@
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "bench.h"
+
+namespace
+{
+    struct BenchCase
+    {
+        const char *name;
+        void (*run)();
+    };
+
+    // a function-local static so registrars in other files can run first
+    std::vector<BenchCase> &benchCases()
+    {
+        static std::vector<BenchCase> cases;
+        return cases;
+    }
+}
+
+BenchRegistrar::BenchRegistrar(const char *name, void (*run)())
+{
+    benchCases().push_back({name, run});
+}
+
+void report(const std::string &what, double seconds, long count)
+{
+    double each = count ? seconds / count : 0;
+    const char *unit = "s";
+    if (each < 1e-6)
+    {
+        each *= 1e9;
+        unit = "ns";
+    }
+    else if (each < 1e-3)
+    {
+        each *= 1e6;
+        unit = "us";
+    }
+    else if (each < 1)
+    {
+        each *= 1e3;
+        unit = "ms";
+    }
+    std::printf("  %-44s %9.2f %s  (%ld in %.3fs)\n", what.c_str(), each, unit, count, seconds);
+    std::fflush(stdout);
+}
+
+void reportRate(const std::string &what, double seconds, long count, const std::string &things)
+{
+    std::printf("  %-44s %9.1f %s/s  (%ld in %.3fs)\n", what.c_str(), seconds > 0 ? count / seconds : 0, things.c_str(), count, seconds);
+    std::fflush(stdout);
+}
+
+// Runs every benchmark, or only the ones named on the command line
+int main(int argc, char *argv[])
+{
+    for (const BenchCase &bench : benchCases())
+    {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; i++)
+        {
+            selected = selected || std::strcmp(argv[i], bench.name) == 0;
+        }
+        if (selected)
+        {
+            std::printf("%s\n", bench.name);
+            bench.run();
+        }
+    }
+    return 0;
+}
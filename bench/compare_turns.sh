@@ -0,0 +1,61 @@
+#!/bin/bash
+# Times a turn of the interactive game at two or more revisions, for changes made before the
+# bench cases existed: bench/compare_turns.sh e7248a7 f1dc4c6
+# Each revision is built with the release flags in its own worktree and plays the same random
+# moves on seeds 1 to 60 with its output thrown away. Seeds that do not finish within
+# 5 seconds at every revision are dropped. A turn's cost is the run time minus the time to
+# start and quit, over the frames drawn. Frames are counted by their "Race:" line, so this
+# only works up to e4c23c5, which started redrawing only the cells that change. Revisions
+# that play a seed the same way compare the same turns; check that with the frame counts.
+
+set -e
+if [ $# -lt 2 ]; then
+    echo "usage: $0 REVISION REVISION..."
+    exit 1
+fi
+
+work=$(mktemp -d)
+trap 'for rev in "$@"; do git worktree remove --force "$work/$rev" 2>/dev/null; done; rm -rf "$work"' EXIT
+
+# h picks a human, then 20000 random moves and a q
+{
+    echo h
+    moves=(no so ea we ne nw se sw)
+    RANDOM=1
+    for i in $(seq 20000); do echo "${moves[RANDOM % 8]}"; done
+    echo q
+} > "$work/moves.txt"
+printf 'h\nq\n' > "$work/quit.txt"
+
+for rev in "$@"; do
+    git worktree add --detach "$work/$rev" "$rev" > /dev/null 2>&1
+    make -C "$work/$rev" -j"$(nproc)" CXXFLAGS="-Iinclude -std=c++14 -Wall -pthread -O2 -DNDEBUG" LDFLAGS=-pthread cc3k > /dev/null 2>&1
+done
+
+seeds=""
+for seed in $(seq 60); do
+    finished=1
+    for rev in "$@"; do
+        timeout 5 "$work/$rev/cc3k" --seed "$seed" < "$work/moves.txt" > /dev/null 2>&1 || finished=0
+    done
+    [ $finished = 1 ] && seeds="$seeds $seed"
+done
+
+# nanoseconds to play every seed with input
+play() {
+    local start=$(date +%s%N)
+    for seed in $seeds; do "$1" --seed "$seed" < "$2" > /dev/null 2>&1; done
+    echo $(($(date +%s%N) - start))
+}
+
+for rev in "$@"; do
+    binary="$work/$rev/cc3k"
+    frames=$(for seed in $seeds; do "$binary" --seed "$seed" < "$work/moves.txt" 2>&1; done | grep -c "^Race:" || true)
+    if [ "$frames" = 0 ]; then
+        echo "$rev: no frames with a Race: line"
+        continue
+    fi
+    total=$(play "$binary" "$work/moves.txt")
+    startup=$(play "$binary" "$work/quit.txt")
+    echo "$rev: $(echo $seeds | wc -w) games, $frames frames, $(((total - startup) / frames / 1000))us per turn"
+done
@@ -0,0 +1,166 @@
+#include <cctype>
+#include <cstdio>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <unistd.h>
+#include "bench.h"
+#include "components/components.h"
+#include "constants/colours.h"
+#include "constants/game_data.h"
+#include "game/game.h"
+#include "game/policy.h"
+#include "systems/display_system.h"
+
+namespace
+{
+    const long FRAMES = 10000;
+
+    enum class Renderer
+    {
+        DIFF,   // DisplaySystem as the game runs it
+        FULL,   // DisplaySystem drawing every frame in full
+        STREAM, // the renderer DisplaySystem replaced
+    };
+
+    void outputColor(char c)
+    {
+        if (c == '|' || c == '-' || c == '+' || c == '#' || c == ' ')
+            std::cout << MAG;
+        else if (c == '.')
+            std::cout << MAG;
+        else if (c == 'G')
+            std::cout << BHYEL;
+        else if (c == 'C' || c == 'B')
+            std::cout << BHGRN;
+        else if (c == '@' || c == '\\')
+            std::cout << BHWHT;
+        else if (c == 'P')
+            std::cout << BHCYN;
+        else if (c == 'V' || c == 'W' || c == 'N' || c == 'M' || c == 'D' || c == 'X' || c == 'T')
+            std::cout << BHRED;
+        std::cout << c << COLOR_RESET;
+    }
+
+    // The frame as the game drew it before DisplaySystem composed frames: every cell through
+    // std::cout with its own colour escapes, a std::endl and so a flush after every row.
+    void renderToStream(EntityManager &floor, Entity player, int level, GameContext &context)
+    {
+        const FloorMap &map = floor.getMap();
+        for (int row = 0; row < map.getHeight(); row++)
+        {
+            for (int col = 0; col < map.getWidth(); col++)
+            {
+                Entity entity = floor.getEntity(row, col);
+                if (entity && !(entity.hasComponent<StairsComponent>() && !player.hasComponent<CompassComponent>()))
+                {
+                    outputColor(entity.getComponent<DisplayComponent>()->display_char);
+                }
+                else
+                {
+                    outputColor(map.tile(row, col));
+                }
+            }
+            std::cout << std::endl;
+        }
+
+        int attack = player.getComponent<AttackComponent>()->attackPower;
+        int defense = player.getComponent<DefenseComponent>()->defensePower;
+        if (PotionEffectComponent *effect = player.getComponent<PotionEffectComponent>())
+        {
+            attack += effect->attackChange;
+            defense += effect->defenseChange;
+        }
+        std::ostringstream goldStream;
+        goldStream << std::fixed << std::setprecision(1) << player.getComponent<GoldComponent>()->gold;
+
+        std::cout << "Race: " << traitsOf(player.getComponent<PlayerRaceComponent>()->race).name << " Gold: " << goldStream.str()
+                  << " Floor: " << level + 1 << std::endl;
+        std::cout << "HP: " << player.getComponent<HealthComponent>()->currentHealth << std::endl;
+        std::cout << "Atk: " << attack << std::endl;
+        std::cout << "Def: " << defense << std::endl;
+        std::cout << "Action: ";
+        for (std::size_t i = 0; i < context.actionMessage.size(); i++)
+        {
+            context.actionMessage[i][0] = std::toupper(context.actionMessage[i][0]);
+            std::cout << context.actionMessage[i];
+            if (i != context.actionMessage.size() - 1)
+            {
+                std::cout << " ";
+            }
+        }
+        std::cout << "\n";
+    }
+
+    // Renders FRAMES frames of random-policy games with stdout on /dev/null, so the time is
+    // composing and writing frames rather than a terminal drawing them.
+    void renderFrames(Renderer renderer)
+    {
+        std::fflush(stdout);
+        int terminal = dup(1);
+        int null = open("/dev/null", O_WRONLY);
+        dup2(null, 1);
+        close(null);
+
+        Game game;
+        DisplaySystem display(game.getContext());
+        long frames = 0;
+        double seconds = 0;
+        for (int seed = 1; frames < FRAMES; seed++)
+        {
+            RandomPolicy policy(seed);
+            game.reset(Race::HUMAN, seed);
+            display.invalidate();
+            for (; frames < FRAMES && !game.isOver(); frames++)
+            {
+                std::string input = policy.nextCommand(game);
+                try
+                {
+                    game.turn(input);
+                }
+                catch (...)
+                {
+                }
+                game.getContext().actionMessage.clear();
+                if (game.isWon())
+                {
+                    break;
+                }
+
+                Stopwatch watch;
+                if (renderer == Renderer::STREAM)
+                {
+                    renderToStream(game.currentFloor(), game.getPlayer(), game.getFloor(), game.getContext());
+                    std::cout.flush();
+                }
+                else
+                {
+                    if (renderer == Renderer::FULL)
+                    {
+                        display.invalidate();
+                    }
+                    display.update(game.currentFloor(), game.getPlayer(), game.getFloor());
+                }
+                seconds += watch.seconds();
+            }
+        }
+
+        dup2(terminal, 1);
+        close(terminal);
+        if (renderer == Renderer::STREAM)
+        {
+            report("std::cout frame to /dev/null", seconds, frames);
+            return;
+        }
+        report(renderer == Renderer::FULL ? "full frame to /dev/null" : "diff frame to /dev/null", seconds, frames);
+        std::printf("  %-44s %9.0f bytes\n", "per frame", double(display.totalFrameBytes()) / frames);
+    }
+}
+
+BENCH(frames)
+{
+    renderFrames(Renderer::DIFF);
+    renderFrames(Renderer::FULL);
+    renderFrames(Renderer::STREAM);
+}
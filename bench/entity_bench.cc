@@ -0,0 +1,176 @@
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+#include "bench.h"
+#include "game/game.h"
+
+namespace
+{
+// How entities held their components before the packed pools: a hash map from the component's
+// type to a shared_ptr of a polymorphic base, a lookup hashing the type and copying the pointer.
+struct Component
+{
+    virtual ~Component() = default;
+};
+
+template <typename T>
+struct Boxed : Component
+{
+    T value;
+    explicit Boxed(const T &value) : value(value) {}
+};
+
+class MapEntity
+{
+    std::unordered_map<std::type_index, std::shared_ptr<Component>> components;
+
+public:
+    template <typename T>
+    void addComponent(const T &component)
+    {
+        components[typeid(T)] = std::make_shared<Boxed<T>>(component);
+    }
+
+    template <typename T>
+    std::shared_ptr<Boxed<T>> getComponent()
+    {
+        auto it = components.find(typeid(T));
+        if (it != components.end())
+        {
+            return std::static_pointer_cast<Boxed<T>>(it->second);
+        }
+        return nullptr;
+    }
+};
+
+// a map entity for every entity of floor, holding copies of the components the bench reads
+std::vector<MapEntity> mapEntities(EntityManager &floor)
+{
+    std::vector<MapEntity> entities;
+    for (EntityId id : floor.getEntities())
+    {
+        Entity entity{&floor, id};
+        entities.emplace_back();
+        MapEntity &copy = entities.back();
+        copy.addComponent(*entity.getComponent<PositionComponent>());
+        if (entity.hasComponent<EnemyTypeComponent>())
+        {
+            copy.addComponent(*entity.getComponent<EnemyTypeComponent>());
+        }
+        if (entity.hasComponent<ItemTypeComponent>())
+        {
+            copy.addComponent(*entity.getComponent<ItemTypeComponent>());
+        }
+        if (entity.hasComponent<HealthComponent>())
+        {
+            copy.addComponent(*entity.getComponent<HealthComponent>());
+        }
+    }
+    return entities;
+}
+} // namespace
+
+// Component lookups through Entity handles, over every entity of a generated floor: a presence
+// check is a signature bit test, a fetch a bit test and two array reads. The same lookups on
+// the map every entity used to hold follow as the baseline.
+BENCH(lookups)
+{
+    Game game;
+    game.reset(Race::HUMAN, 1);
+    EntityManager &floor = game.currentFloor();
+    const int rounds = 2000000;
+
+    long checks = 0, found = 0;
+    Stopwatch hasWatch;
+    for (int round = 0; round < rounds; round++)
+    {
+        for (EntityId id : floor.getEntities())
+        {
+            Entity entity{&floor, id};
+            found += entity.hasComponent<EnemyTypeComponent>();
+            found += entity.hasComponent<ItemTypeComponent>();
+            checks += 2;
+        }
+    }
+    keep(found);
+    report("hasComponent", hasWatch.seconds(), checks);
+
+    long fetches = 0, sum = 0;
+    Stopwatch getWatch;
+    for (int round = 0; round < rounds; round++)
+    {
+        for (EntityId id : floor.getEntities())
+        {
+            Entity entity{&floor, id};
+            sum += entity.getComponent<PositionComponent>()->row;
+            HealthComponent *health = entity.getComponent<HealthComponent>();
+            sum += health ? health->currentHealth : 0;
+            fetches += 2;
+        }
+    }
+    keep(sum);
+    report("getComponent", getWatch.seconds(), fetches);
+
+    long visited = 0;
+    Stopwatch forEachWatch;
+    for (int round = 0; round < rounds; round++)
+    {
+        floor.forEach<EnemyTypeComponent, PositionComponent>([&sum, &visited](Entity, EnemyTypeComponent &, PositionComponent &position)
+                                                             {
+                                                                 sum += position.col;
+                                                                 visited++;
+                                                             });
+    }
+    keep(sum);
+    report("forEach<EnemyType, Position>, per enemy", forEachWatch.seconds(), visited);
+
+    // the baseline: the old way of checking, fetching and finding the enemies among the entities
+    std::vector<MapEntity> entities = mapEntities(floor);
+    const int mapRounds = rounds / 10;
+
+    checks = 0;
+    Stopwatch mapHasWatch;
+    for (int round = 0; round < mapRounds; round++)
+    {
+        for (MapEntity &entity : entities)
+        {
+            found += entity.getComponent<EnemyTypeComponent>() != nullptr;
+            found += entity.getComponent<ItemTypeComponent>() != nullptr;
+            checks += 2;
+        }
+    }
+    keep(found);
+    report("map: presence check", mapHasWatch.seconds(), checks);
+
+    fetches = 0;
+    Stopwatch mapGetWatch;
+    for (int round = 0; round < mapRounds; round++)
+    {
+        for (MapEntity &entity : entities)
+        {
+            sum += entity.getComponent<PositionComponent>()->value.row;
+            std::shared_ptr<Boxed<HealthComponent>> health = entity.getComponent<HealthComponent>();
+            sum += health ? health->value.currentHealth : 0;
+            fetches += 2;
+        }
+    }
+    keep(sum);
+    report("map: fetch", mapGetWatch.seconds(), fetches);
+
+    visited = 0;
+    Stopwatch mapScanWatch;
+    for (int round = 0; round < mapRounds; round++)
+    {
+        for (MapEntity &entity : entities)
+        {
+            if (entity.getComponent<EnemyTypeComponent>())
+            {
+                sum += entity.getComponent<PositionComponent>()->value.col;
+                visited++;
+            }
+        }
+    }
+    keep(sum);
+    report("map: scan for EnemyType, Position, per enemy", mapScanWatch.seconds(), visited);
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "bench.h"
+#include "game/game.h"
+#include "game/policy.h"
+#include "game/runner.h"
+#include "game/work_stealing_pool.h"
+
+// Whole turns through the system pipeline on generated floors, the way the headless runner
+// plays them: one Game reused for every game, commands from the random policy. Revisions from
+// before this harness, and so the packed component pools against the tree they replaced, are
+// compared with bench/compare_turns.sh.
+BENCH(turns)
+{
+    for (bool prefetch : {true, false})
+    {
+        Game game;
+        game.setPrefetch(prefetch);
+        long turns = 0;
+        Stopwatch watch;
+        for (int seed = 1; seed <= 300; seed++)
+        {
+            RandomPolicy policy(seed);
+            playGame(game, policy, Race::HUMAN, seed);
+            turns += game.getStats().turns;
+        }
+        report(prefetch ? "turn, 300 games" : "turn, 300 games, no prefetch", watch.seconds(), turns);
+    }
+}
+
+// Whole games spread over a WorkStealingPool like the headless runner spreads them, each worker
+// reusing its own Game, at 1 up to twice as many threads as there are cores. Games share
+// nothing, so games/s should grow with the thread count until the cores run out.
+BENCH(threads)
+{
+    const int games = 200;
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("  cores: %u\n", cores);
+    for (unsigned threads = 1; threads <= std::max(2 * cores, 4u); threads *= 2)
+    {
+        WorkStealingPool pool(threads);
+        std::vector<std::unique_ptr<Game>> workerGames;
+        for (unsigned worker = 0; worker < pool.size(); worker++)
+        {
+            // no background floor builds, so a game keeps to the one thread that plays it
+            workerGames.emplace_back(new Game());
+            workerGames.back()->setPrefetch(false);
+        }
+        std::vector<int> turns(games);
+        for (int i = 0; i < games; i++)
+        {
+            pool.submit([&workerGames, &turns, i](unsigned worker)
+                        {
+                            RandomPolicy policy(i + 1);
+                            playGame(*workerGames[worker], policy, Race::HUMAN, i + 1);
+                            turns[i] = workerGames[worker]->getStats().turns;
+                        });
+        }
+        Stopwatch watch;
+        pool.run();
+        reportRate("games, " + std::to_string(threads) + (threads == 1 ? " thread" : " threads"), watch.seconds(), games, "games");
+        keep(turns);
+    }
+}
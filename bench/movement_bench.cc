@@ -0,0 +1,156 @@
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "bench.h"
+#include "components/components.h"
+#include "entities/entity_manager.h"
+#include "game/game_context.h"
+#include "map/floor_map.h"
+#include "map/flow_field.h"
+#include "systems/movement_system.h"
+
+namespace
+{
+// An open side x side room walled all round, the player standing still in its middle and
+// enemies wandering goblins on random free cells, the same ones for every run.
+struct Room
+{
+    std::shared_ptr<const FloorMap> map;
+    EntityManager entities;
+    GameContext context;
+    Entity player;
+
+    Room(int side, int enemies)
+    {
+        std::vector<std::string> layout(side, std::string(side, '.'));
+        layout[0] = layout[side - 1] = std::string(side, '-');
+        for (int row = 1; row < side - 1; row++)
+        {
+            layout[row][0] = layout[row][side - 1] = '|';
+        }
+        map = std::make_shared<const FloorMap>(layout);
+        entities.setMap(map);
+        context.reset(1);
+
+        player = entities.createEntity();
+        ActionComponent action;
+        action.move = false;
+        player.addComponent(action);
+        entities.setPosition(player, side / 2, side / 2);
+
+        std::mt19937 cells(7);
+        for (int i = 0; i < enemies; i++)
+        {
+            Entity enemy = entities.createEntity();
+            enemy.addComponent(EnemyTypeComponent(EnemyKind::GOBLIN));
+            enemy.addComponent(MoveableComponent(true));
+            int row, col;
+            do
+            {
+                row = 1 + cells() % (side - 2);
+                col = 1 + cells() % (side - 2);
+            } while (entities.getEntity(row, col));
+            entities.setPosition(enemy, row, col);
+        }
+    }
+};
+
+void timeTurns(const std::string &what, Room &room, MovementSystem &movement, long turns)
+{
+    movement.update(room.entities, room.player);
+    Stopwatch watch;
+    for (long turn = 0; turn < turns; turn++)
+    {
+        movement.update(room.entities, room.player);
+    }
+    report(what, watch.seconds(), turns);
+}
+} // namespace
+
+// Scheduling and moving every enemy each turn, which is mostly the row-major sort of the turn
+// order once there are hundreds of them.
+BENCH(turnOrder)
+{
+    struct Case
+    {
+        const char *what;
+        int side, enemies;
+        long turns;
+    };
+    const Case cases[] = {
+        {"turn, 20 enemies in 79x79", 79, 20, 200000},
+        {"turn, 500 enemies in 200x200", 200, 500, 20000},
+        {"turn, 10k enemies in 1000x1000", 1000, 10000, 500},
+    };
+    for (const Case &c : cases)
+    {
+        Room room(c.side, c.enemies);
+        MovementSystem movement(room.context);
+        timeTurns(c.what, room, movement, c.turns);
+    }
+}
+
+// 1k goblins on a 1000x1000 floor while the player steps every turn, wandering and then chasing
+// along the flow field, which is searched again every time the player steps.
+BENCH(chase)
+{
+    const int side = 1000;
+    const long turns = 2000;
+    const int rowSteps[] = {0, 1, 0, -1}, colSteps[] = {1, 0, -1, 0};
+    for (bool chase : {false, true})
+    {
+        Room room(side, 1000);
+        MovementSystem movement(room.context);
+        movement.setChase(chase);
+        int row = side / 2, col = side / 2;
+        Stopwatch watch;
+        for (long turn = 0; turn < turns; turn++)
+        {
+            // sidesteps when a goblin is in the way, the chasers soon crowd every turn of the square
+            for (int tried = 0; tried < 4; tried++)
+            {
+                int step = (turn / 5 + tried) % 4;
+                if (!room.entities.getEntity(row + rowSteps[step], col + colSteps[step]))
+                {
+                    row += rowSteps[step];
+                    col += colSteps[step];
+                    room.entities.setPosition(room.player, row, col);
+                    break;
+                }
+            }
+            movement.update(room.entities, room.player);
+        }
+        report(chase ? "turn, chasing" : "turn, wandering", watch.seconds(), turns);
+    }
+
+    // one search by itself, out to the 79 steps MovementSystem bounds it to
+    Room room(side, 0);
+    FlowField field;
+    const long searches = 2000;
+    Stopwatch watch;
+    for (long i = 0; i < searches; i++)
+    {
+        field.update(room.map->enemyWalkable(), side / 2 + i % 100, side / 2 + i / 100, 79);
+    }
+    report("flow field search", watch.seconds(), searches);
+    keep(field);
+}
+
+// What a turn costs as a 1000x1000 floor fills up, every enemy moving against only those within
+// 20 rows and columns of the player.
+BENCH(activeRadius)
+{
+    const int counts[] = {20, 500, 10000, 50000};
+    for (int enemies : counts)
+    {
+        Room room(1000, enemies);
+        for (int radius : {0, 20})
+        {
+            MovementSystem movement(room.context);
+            movement.setActiveRadius(radius);
+            std::string what = "turn, " + std::to_string(enemies) + (radius ? " enemies, radius 20" : " enemies, all moving");
+            timeTurns(what, room, movement, radius ? 20000 : 20000000 / (enemies + 1000));
+        }
+    }
+}
@@ -0,0 +1,323 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "bench.h"
+#include "components/components.h"
+#include "constants/constants.h"
+#include "constants/game_data.h"
+#include "entities/entity_manager.h"
+#include "game/floor_cache.h"
+#include "map/floor_file.h"
+#include "systems/spawn_system.h"
+
+namespace
+{
+// Enemies and potions built the way SpawnSystem built them before blueprints: a component at a
+// time from the traits, giving the entities the blueprints stamp.
+void constructEnemy(EntityManager &floor, int row, int col, EnemyKind kind, bool withCompass)
+{
+    const EnemyTraits &traits = traitsOf(kind);
+    Entity enemy = floor.createEntity();
+    enemy.addComponent(DisplayComponent(traits.display));
+    enemy.addComponent(HealthComponent(traits.health));
+    enemy.addComponent(AttackComponent(traits.attack));
+    enemy.addComponent(DefenseComponent(traits.defense));
+    enemy.addComponent(GoldComponent(traits.gold));
+    if (traits.hostile)
+    {
+        enemy.addComponent(HostileComponent());
+    }
+    enemy.addComponent(MoveableComponent(true));
+    enemy.addComponent(EnemyTypeComponent(kind));
+    enemy.addComponent(PositionComponent(row, col));
+    if (withCompass)
+    {
+        enemy.addComponent(CompassComponent());
+    }
+}
+
+void constructPotion(EntityManager &floor, int row, int col, PotionKind kind)
+{
+    Entity potion = floor.createEntity();
+    potion.addComponent(DisplayComponent('P'));
+    potion.addComponent(PotionTypeComponent(kind));
+    potion.addComponent(CanPickupComponent());
+    potion.addComponent(PositionComponent(row, col));
+}
+
+// 20 enemies and 10 potions into a cleared floor, rounds times, the mix newFloor spawns, in the
+// first room of the board
+template <typename SpawnEnemy, typename SpawnPotion>
+void timeSpawns(const std::string &what, SpawnEnemy spawnEnemy, SpawnPotion spawnPotion)
+{
+    EntityManager floor;
+    const long rounds = 200000;
+    Stopwatch watch;
+    for (long round = 0; round < rounds; round++)
+    {
+        floor.clear();
+        for (int i = 0; i < 20; i++)
+        {
+            spawnEnemy(floor, 3 + i / 10, 3 + i % 10, EnemyKind(i % int(EnemyKind::COUNT)), i == 0);
+        }
+        for (int i = 0; i < 10; i++)
+        {
+            spawnPotion(floor, 5, 3 + i, PotionKind(i % int(PotionKind::COUNT)));
+        }
+    }
+    report(what, watch.seconds(), rounds * 30);
+    keep(floor.getEntities().size());
+}
+
+// Puts the player next to the stairs facing them and lets SpawnSystem::update take them, as if
+// the player had walked there.
+void takeStairs(SpawnSystem &spawnSystem, EntityManager &floor, int &level)
+{
+    Entity player, stairs;
+    floor.forEach<PlayerRaceComponent>([&player](Entity entity, PlayerRaceComponent &)
+                                       { player = entity; });
+    floor.forEach<StairsComponent>([&stairs](Entity entity, StairsComponent &)
+                                   { stairs = entity; });
+    PositionComponent target = *stairs.getComponent<PositionComponent>();
+    for (std::size_t direction = 0; direction < std::size_t(Direction::COUNT); direction++)
+    {
+        int row = target.row - DIRECTION_ROW[direction];
+        int col = target.col - DIRECTION_COL[direction];
+        if (floor.getMap().roomFloor().test(row, col) && !floor.getEntity(row, col))
+        {
+            floor.setPosition(player, row, col);
+            player.getComponent<DirectionComponent>()->direction = Direction(direction);
+            player.getComponent<ActionComponent>()->move = true;
+            spawnSystem.update(floor, level, player);
+            return;
+        }
+    }
+}
+
+// floors floors of a side x side room, each with the player, the stairs and enemies goblins
+std::shared_ptr<const FloorFile> bigFloors(int floors, int side, int enemies)
+{
+    std::string text;
+    for (int floor = 0; floor < floors; floor++)
+    {
+        std::vector<std::string> rows(side, "|" + std::string(side - 2, '.') + "|");
+        rows[0] = rows[side - 1] = std::string(side, '-');
+        rows[1][1] = '@';
+        rows[side - 2][side - 2] = '\\';
+        for (int i = 0; i < enemies; i++)
+        {
+            rows[2 + i / (side - 4)][2 + i % (side - 4)] = traitsOf(EnemyKind::GOBLIN).display;
+        }
+        for (const std::string &row : rows)
+        {
+            text += row + '\n';
+        }
+        text += '\n';
+    }
+    return std::make_shared<const FloorFile>(parseFloorFile(text.data(), text.size(), "big floors"));
+}
+
+// bytes of the process in memory, from /proc/self/statm; 0 where there is none
+double residentBytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    long size = 0, resident = 0;
+    statm >> size >> resident;
+    return double(resident) * sysconf(_SC_PAGESIZE);
+}
+
+void reportMemory(const std::string &what, double bytes)
+{
+    std::printf("  %-44s %9.2f MB\n", what.c_str(), bytes / (1 << 20));
+    std::fflush(stdout);
+}
+
+// Pages floors of one kind into a cache as a game of count floors stores them, built in order,
+// and back out of it, then keeps them all in managers of their own instead, reporting the time of a page out and
+// in and how much the process grew to hold the floors each way.
+template <typename Build>
+void timePaging(const std::string &what, int count, Build build)
+{
+    EntityManager floor;
+    FloorCache cache;
+    cache.use(1, Race::HUMAN, count);
+    double pageOutSeconds = 0, pageBytes = 0, paged = 0;
+    for (int i = 0; i < count; i++)
+    {
+        build(floor, i);
+        // only the stores, building may grow the process too
+        double before = residentBytes();
+        Stopwatch watch;
+        cache.store(i, floor);
+        pageOutSeconds += watch.seconds();
+        paged += residentBytes() - before;
+        pageBytes += cache.find(i)->bytes.size();
+    }
+    report("page out, " + what, pageOutSeconds, count);
+
+    Stopwatch pageInWatch;
+    for (int i = 0; i < count; i++)
+    {
+        floor.pageIn(*cache.find(i));
+        keep(floor.getEntities().size());
+    }
+    report("page in, " + what, pageInWatch.seconds(), count);
+
+    std::vector<std::unique_ptr<EntityManager>> resident;
+    double before = residentBytes();
+    for (int i = 0; i < count; i++)
+    {
+        resident.emplace_back(new EntityManager());
+        resident.back()->pageIn(*cache.find(i));
+    }
+    std::string floors = std::to_string(count) + " floors";
+    reportMemory("  " + floors + ", pages", pageBytes);
+    reportMemory("  " + floors + ", paged, process grew", paged);
+    reportMemory("  " + floors + ", in managers, process grew", residentBytes() - before);
+}
+} // namespace
+
+// Generating stock floors into one recycled manager: placement and spawning, no cache.
+BENCH(floors)
+{
+    SpawnSystem spawnSystem;
+    EntityManager floor;
+    const long floors = 100000;
+    long entities = 0;
+    Stopwatch watch;
+    for (long i = 0; i < floors; i++)
+    {
+        spawnSystem.newFloor(floor, i * 7 + 1, i % 5 == 0, Race::HUMAN);
+        entities += floor.getEntities().size();
+    }
+    report("generated floor", watch.seconds(), floors);
+    keep(entities);
+}
+
+// Stamping entities from the blueprints, against building them a component at a time; the clear
+// of the floor between rounds is in both.
+BENCH(spawns)
+{
+    SpawnSystem spawnSystem;
+    timeSpawns(
+        "spawned entity, blueprint",
+        [&spawnSystem](EntityManager &floor, int row, int col, EnemyKind kind, bool withCompass)
+        { spawnSystem.spawnEnemy(floor, row, col, kind, withCompass); },
+        [&spawnSystem](EntityManager &floor, int row, int col, PotionKind kind)
+        { spawnSystem.spawnPotion(floor, row, col, kind); });
+    timeSpawns("spawned entity, field by field", constructEnemy, constructPotion);
+}
+
+// Parsing and validating the stock game data, from memory and then read from disk each time.
+BENCH(dataLoading)
+{
+    std::ifstream file("cc3kdata.txt");
+    if (!file)
+    {
+        std::printf("  cc3kdata.txt not found, run from the top of the tree\n");
+        return;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string text = contents.str();
+
+    const long parses = 20000;
+    long enemies = 0;
+    Stopwatch parseWatch;
+    for (long i = 0; i < parses; i++)
+    {
+        enemies += parseGameData(text, "cc3kdata.txt").enemySpawns.size();
+    }
+    report("parse cc3kdata.txt", parseWatch.seconds(), parses);
+
+    const long loads = 5000;
+    Stopwatch loadWatch;
+    for (long i = 0; i < loads; i++)
+    {
+        std::ifstream data("cc3kdata.txt");
+        std::stringstream read;
+        read << data.rdbuf();
+        enemies += parseGameData(read.str(), "cc3kdata.txt").enemySpawns.size();
+    }
+    report("read and parse cc3kdata.txt", loadWatch.seconds(), loads);
+    keep(enemies);
+}
+
+// The stall when the player takes the stairs, with the next floor built in the background and
+// without. A game either goes straight on, like the headless runner, or pauses between floors for
+// as long as someone reading the screen would; only a pause gives the worker time of its own
+// on a machine with no spare core.
+BENCH(stairs)
+{
+    struct Case
+    {
+        const char *what;
+        std::shared_ptr<const FloorFile> floors;
+        int floorCount, games;
+    };
+    const Case cases[] = {
+        {"generated floor", nullptr, NUM_FLOORS, 400},
+        {"1000x1000 floor, 20k enemies", bigFloors(5, 1000, 20000), 5, 10},
+    };
+    for (const Case &c : cases)
+    {
+        for (bool pause : {false, true})
+        {
+            for (bool prefetch : {false, true})
+            {
+                SpawnSystem spawnSystem;
+                spawnSystem.setPrefetch(prefetch);
+                EntityManager floor;
+                for (int game = 0; game < c.games; game++)
+                {
+                    spawnSystem.startGame(floor, game + 1, Race::HUMAN, c.floors, c.floorCount, game % c.floorCount);
+                    for (int level = 0; level < c.floorCount - 1;)
+                    {
+                        if (pause)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(c.floors ? 100 : 2));
+                        }
+                        takeStairs(spawnSystem, floor, level);
+                    }
+                }
+                const TransitionStats &stats = spawnSystem.getTransitionStats();
+                std::string what = std::string(c.what) + (pause ? ", paused" : "") + (prefetch ? ", prefetch" : "");
+                report("stairs, " + what, (stats.totalMicroseconds + stats.waitMicroseconds) / 1e6, stats.count);
+                std::printf("  %-44s %9.2f us, built on the stairs %d, waited %d\n", "  longest", stats.maxMicroseconds + stats.maxWaitMicroseconds,
+                            stats.built, stats.waited);
+            }
+        }
+    }
+}
+
+// Paging a game's floors into the cache and back, for a game of hundreds of stock floors and for
+// one of 1000x1000 floors of 20k goblins each, against keeping every floor in a manager of its own.
+// The maps are shared with the floor file either way, so the growth is the entities and, for the
+// managers, their spatial index.
+BENCH(paging)
+{
+    SpawnSystem spawnSystem;
+    timePaging("generated floor", 500, [&spawnSystem](EntityManager &floor, int i)
+               { spawnSystem.newFloor(floor, i * 7 + 1, i % 5 == 0, Race::HUMAN); });
+
+    const int bigCount = 20;
+    std::shared_ptr<const FloorFile> big = bigFloors(bigCount, 1000, 20000);
+    int level = 0;
+    timePaging("1000x1000 floor, 20k enemies", bigCount, [&spawnSystem, &big, &level, bigCount](EntityManager &floor, int i)
+               {
+                   // the floors of one game, built in order
+                   if (i == 0)
+                   {
+                       spawnSystem.startGame(floor, 1, Race::HUMAN, big, bigCount, 0);
+                   }
+                   else
+                   {
+                       takeStairs(spawnSystem, floor, level);
+                   } });
+}
@@ -1,10 +1,9 @@
 #ifndef COMPONENT_H
 #define COMPONENT_H
 
+// Components are plain data stored by value in per-type pools owned by the
+// EntityManager, so the base class carries no virtual interface
 class Component
-{
-public:
-    virtual ~Component() = default;
-};
+{};
 
-#endif
\ No newline at end of file
+#endif
@@ -28,4 +28,37 @@
 #include "components/all_positive_component.h"
 #include "components/guarding_position_component.h"
 
+template <typename... Components>
+struct ComponentList
+{};
+
+// Every component type known to the EntityManager. A component's position in this list is its
+// compile-time id and its bit in an entity's signature, so append new components at the end.
+using AllComponents = ComponentList<
+    ActionComponent,
+    AllPositiveComponent,
+    AttackComponent,
+    BarrierSuitComponent,
+    CanPickupComponent,
+    CompassComponent,
+    DefenseComponent,
+    DirectionComponent,
+    DisplayComponent,
+    EnemyTypeComponent,
+    GoldComponent,
+    GoldMultiplierComponent,
+    GoldStealComponent,
+    GuardingPositionComponent,
+    HealthComponent,
+    HostileComponent,
+    ItemTypeComponent,
+    LifestealComponent,
+    MoveableComponent,
+    PlayerRaceComponent,
+    PositionComponent,
+    PotionEffectComponent,
+    PotionTypeComponent,
+    StairsComponent,
+    TreasureComponent>;
+
 #endif // COMPONENTS_H
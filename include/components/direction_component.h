@@ -2,10 +2,10 @@
 #define DIRECTION_COMPONENT_H
 
 #include "component.h"
-#include <string>
+#include "constants/kinds.h"
 
 class DirectionComponent : public Component {
     public:
-    std::string direction;
+    Direction direction = Direction::NO;
 };
 #endif // DIRECTION_COMPONENT_H
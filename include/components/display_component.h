@@ -6,7 +6,7 @@
 class DisplayComponent : public Component
 {
 public:
-    const char display_char;
+    char display_char;
     DisplayComponent(char display) : display_char{display} {};
 };
 
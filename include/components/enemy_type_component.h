@@ -2,13 +2,13 @@
 #define ENEMY_TYPE_COMPONENT_H
 
 #include "component.h"
-#include <string>
+#include "constants/kinds.h"
 
 class EnemyTypeComponent : public Component
 {
 public:
-    std::string enemy_type;
-    EnemyTypeComponent(std::string enemy_type) : enemy_type{enemy_type} {};
+    EnemyKind enemy_type;
+    EnemyTypeComponent(EnemyKind enemy_type) : enemy_type{enemy_type} {};
 };
 
 #endif // ENEMY_TYPE_COMPONENT_H
@@ -5,7 +5,7 @@
 
 class GuardingPositionComponent : public Component {
     public:
-    const int row, col;
+    int row, col;
     GuardingPositionComponent(int row, int col) : row{row}, col{col} {};
 };
 #endif // GUARDING_POSITION_COMPONENT_H
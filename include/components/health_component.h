@@ -7,7 +7,7 @@ class HealthComponent : public Component
 {
 public:
     HealthComponent(const int max) : maxHealth{max}, currentHealth{max} {}; // one argument since max_heath == current_health on init
-    const int maxHealth;
+    int maxHealth;
     int currentHealth;
 };
 #endif // HEALTH_COMPONENT_H
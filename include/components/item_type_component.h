@@ -2,13 +2,13 @@
 #define ITEM_TYPE_COMPONENT_H
 
 #include "component.h"
-#include <string>
+#include "constants/kinds.h"
 
 class ItemTypeComponent : public Component
 {
 public:
-    std::string item_type;
-    ItemTypeComponent(std::string item_type) : item_type{item_type} {};
+    ItemKind item_type;
+    ItemTypeComponent(ItemKind item_type) : item_type{item_type} {};
 };
 
 #endif // ITEM_TYPE_COMPONENT_H
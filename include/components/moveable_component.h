@@ -1,12 +1,14 @@
 #ifndef MOVEABLE_COMPONENT_H
 #define MOVEABLE_COMPONENT_H
 
+#include <cstdint>
 #include "component.h"
 
 class MoveableComponent : public Component
 {
 public:
     bool moveable;
+    std::uint32_t lastTurn = 0; // the last turn MovementSystem moved it near the player, 0 for never
     MoveableComponent(bool moveable) : moveable{moveable} {};
 };
 
@@ -2,13 +2,13 @@
 #define PLAYER_RACE_COMPONENT_H
 
 #include "component.h"
-#include <string>
+#include "constants/kinds.h"
 
 class PlayerRaceComponent : public Component
 {
 public:
-    std::string race;
-    PlayerRaceComponent(std::string race) : race{race} {};
+    Race race;
+    PlayerRaceComponent(Race race) : race{race} {};
 };
 
 #endif // PLAYER_RACE_COMPONENT_H
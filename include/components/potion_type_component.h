@@ -2,13 +2,13 @@
 #define POTION_TYPE_COMPONENT_H
 
 #include "component.h"
-#include <string>
+#include "constants/kinds.h"
 
 class PotionTypeComponent : public Component
 {
 public:
-    std::string potion_type;
-    PotionTypeComponent(std::string potion_type) : potion_type{potion_type} {};
+    PotionKind potion_type;
+    PotionTypeComponent(PotionKind potion_type) : potion_type{potion_type} {};
 };
 
 #endif // POTION_TYPE_COMPONENT_H
@@ -0,0 +1,52 @@
+#ifndef GAME_DATA_H
+#define GAME_DATA_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "constants/kinds.h"
+
+// one entry of a weighted draw, walked in file order
+struct EnemyRoll
+{
+    EnemyKind kind;
+    int weight;
+};
+
+struct TreasureRoll
+{
+    int value;
+    int weight;
+    bool hoard; // guarded by a dragon and only picked up once it is slain
+};
+
+// Stats of every race, enemy and potion and the spawn tables, indexed by kind.
+// See cc3kdata.txt for the file format; the same data is compiled in as the default.
+struct GameData
+{
+    EnemyTraits enemies[std::size_t(EnemyKind::COUNT)];
+    PotionTraits potions[std::size_t(PotionKind::COUNT)];
+    RaceTraits races[std::size_t(Race::COUNT)];
+    std::vector<EnemyRoll> enemySpawns;
+    std::vector<TreasureRoll> treasures;
+    int enemySpawnWeight = 0;
+    int treasureWeight = 0;
+    std::uint64_t hash = 0; // of the text it was parsed from, replay logs keep it
+};
+
+// Parses and validates game data, throws "source:line: what is wrong" as a string.
+// Every race, enemy and potion has to be defined exactly once. Enemy glyphs have to be unique and
+// unlike the map, floor file, player, potion and item glyphs; health, attack and the gold and
+// score multipliers have to be positive.
+GameData parseGameData(const std::string &text, const std::string &source);
+// Replaces the data every game uses. Call it before any game starts, the data is read
+// without locking while games run.
+void loadGameData(const std::string &path);
+// the loaded data, or the compiled-in default when nothing was loaded
+const GameData &gameData();
+
+inline const EnemyTraits &traitsOf(EnemyKind kind) { return gameData().enemies[std::size_t(kind)]; }
+inline const PotionTraits &traitsOf(PotionKind kind) { return gameData().potions[std::size_t(kind)]; }
+inline const RaceTraits &traitsOf(Race race) { return gameData().races[std::size_t(race)]; }
+
+#endif // GAME_DATA_H
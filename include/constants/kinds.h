@@ -0,0 +1,174 @@
+#ifndef KINDS_H
+#define KINDS_H
+
+#include <cstdint>
+#include <string>
+
+// What kind of enemy, potion, item or player race an entity is. Components hold these as a
+// single byte, and everything that used to be spelled out per name is looked up in tables
+// indexed by the enum value.
+
+enum class EnemyKind : std::uint8_t
+{
+    VAMPIRE,
+    WEREWOLF,
+    TROLL,
+    GOBLIN,
+    MERCHANT,
+    DRAGON,
+    PHOENIX,
+    COUNT
+};
+
+enum class PotionKind : std::uint8_t
+{
+    RH, // restore health
+    BA, // boost attack
+    BD, // boost defense
+    PH, // poison health
+    WA, // wound attack
+    WD, // wound defense
+    COUNT
+};
+
+enum class ItemKind : std::uint8_t
+{
+    TREASURE,
+    COMPASS,
+    BARRIER_SUIT,
+    STAIRS,
+    COUNT
+};
+
+// Numbered like the bits of a neighbour mask (see map/bitboard.h), so the legal moves of an
+// entity are a mask with one bit per direction
+enum class Direction : std::uint8_t
+{
+    NW,
+    NO,
+    NE,
+    WE,
+    EA,
+    SW,
+    SO,
+    SE,
+    COUNT
+};
+
+enum class Race : std::uint8_t
+{
+    HUMAN,
+    DWARF,
+    ELF,
+    ORC,
+    COUNT
+};
+
+// Names are fixed here, everything else about a kind is game data (see constants/game_data.h)
+constexpr const char *ENEMY_NAMES[] = {"vampire", "werewolf", "troll", "goblin", "merchant", "dragon", "phoenix"};
+constexpr const char *POTION_NAMES[] = {"RH", "BA", "BD", "PH", "WA", "WD"};
+constexpr const char *DIRECTION_NAMES[] = {"nw", "no", "ne", "we", "ea", "sw", "so", "se"};
+constexpr int DIRECTION_ROW[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+constexpr int DIRECTION_COL[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+constexpr const char *RACE_NAMES[] = {"human", "dwarf", "elf", "orc"};
+constexpr char RACE_LETTERS[] = {'h', 'd', 'e', 'o'}; // what the race prompt and replay logs use
+
+static_assert(sizeof(ENEMY_NAMES) / sizeof(ENEMY_NAMES[0]) == std::size_t(EnemyKind::COUNT), "one name per enemy kind");
+static_assert(sizeof(POTION_NAMES) / sizeof(POTION_NAMES[0]) == std::size_t(PotionKind::COUNT), "one name per potion kind");
+static_assert(sizeof(DIRECTION_NAMES) / sizeof(DIRECTION_NAMES[0]) == std::size_t(Direction::COUNT), "one name per direction");
+static_assert(sizeof(DIRECTION_ROW) / sizeof(DIRECTION_ROW[0]) == std::size_t(Direction::COUNT), "one row offset per direction");
+static_assert(sizeof(DIRECTION_COL) / sizeof(DIRECTION_COL[0]) == std::size_t(Direction::COUNT), "one column offset per direction");
+static_assert(sizeof(RACE_NAMES) / sizeof(RACE_NAMES[0]) == std::size_t(Race::COUNT), "one name per race");
+static_assert(sizeof(RACE_LETTERS) == std::size_t(Race::COUNT), "one letter per race");
+
+struct EnemyTraits
+{
+    const char *name;
+    char display;
+    int health;
+    int attack;
+    int defense;
+    int gold; // dropped when slain
+    bool hostile;
+};
+
+struct PotionTraits
+{
+    const char *name;
+    int health;          // added to the current health, a gain never goes past the maximum
+    int attack;          // added to the potion effect, a loss never takes attack below 0
+    int defense;         // the same for defense
+    PotionKind positive; // what an elf gets instead
+};
+
+struct RaceTraits
+{
+    const char *name;
+    char letter;
+    int health;
+    int attack;
+    int defense;
+    float goldMultiplier;
+    float scoreMultiplier; // of the gold the player wins with
+    bool allPositive; // every potion acts as its positive counterpart
+};
+
+// items have no stats, so they are not game data
+struct ItemTraits
+{
+    const char *name;
+    char display;
+};
+
+constexpr ItemTraits ITEM_TRAITS[] = {
+    {"treasure", 'G'},
+    {"compass", 'C'},
+    {"barrier_suit", 'B'},
+    {"stairs", '\\'},
+};
+
+static_assert(sizeof(ITEM_TRAITS) / sizeof(ITEM_TRAITS[0]) == std::size_t(ItemKind::COUNT), "one row per item kind");
+
+inline const ItemTraits &traitsOf(ItemKind kind) { return ITEM_TRAITS[std::size_t(kind)]; }
+
+// the direction a command spells, Direction::COUNT for anything else
+inline Direction directionFromName(const std::string &name)
+{
+    for (std::size_t direction = 0; direction < std::size_t(Direction::COUNT); direction++)
+    {
+        if (name == DIRECTION_NAMES[direction])
+        {
+            return Direction(direction);
+        }
+    }
+    return Direction::COUNT;
+}
+
+inline const char *nameOf(Direction direction) { return DIRECTION_NAMES[std::size_t(direction)]; }
+
+// the race a prompt letter or a name stands for, throws for anything else
+inline Race raceFromLetter(char letter)
+{
+    for (std::size_t race = 0; race < std::size_t(Race::COUNT); race++)
+    {
+        if (RACE_LETTERS[race] == letter)
+        {
+            return Race(race);
+        }
+    }
+    throw std::string("Unknown race");
+}
+
+inline Race raceFromName(const std::string &name)
+{
+    for (std::size_t race = 0; race < std::size_t(Race::COUNT); race++)
+    {
+        if (name == RACE_NAMES[race])
+        {
+            return Race(race);
+        }
+    }
+    throw "Unknown race " + name;
+}
+
+#endif // KINDS_H
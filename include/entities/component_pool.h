@@ -0,0 +1,171 @@
+#ifndef COMPONENT_POOL_H
+#define COMPONENT_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "entities/storage_allocator.h"
+
+using EntityId = std::uint32_t;
+
+// Sparse set: components of one type are packed contiguously in `components`,
+// `owners` maps a dense slot back to its entity and `slots` maps an entity to its dense slot
+template <typename T>
+class ComponentPool
+{
+    static const std::uint32_t EMPTY = UINT32_MAX;
+
+    StorageVector<T> components;
+    StorageVector<EntityId> owners;
+    StorageVector<std::uint32_t> slots;
+
+    // plain data is written as one block
+    void saveComponents(std::string &out, std::true_type) const
+    {
+        out.append(reinterpret_cast<const char *>(components.data()), components.size() * sizeof(T));
+    }
+
+    const char *loadComponents(const char *in, std::uint32_t count, std::true_type)
+    {
+        for (std::uint32_t i = 0; i < count; i++, in += sizeof(T))
+        {
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type bytes;
+            std::memcpy(&bytes, in, sizeof(T));
+            components.push_back(*reinterpret_cast<const T *>(&bytes));
+        }
+        return in;
+    }
+
+    // anything else provides saveComponent and loadComponent next to its definition
+    void saveComponents(std::string &out, std::false_type) const
+    {
+        for (const T &component : components)
+        {
+            saveComponent(out, component);
+        }
+    }
+
+    const char *loadComponents(const char *in, std::uint32_t count, std::false_type)
+    {
+        for (std::uint32_t i = 0; i < count; i++)
+        {
+            T component;
+            in = loadComponent(in, component);
+            components.push_back(std::move(component));
+        }
+        return in;
+    }
+
+public:
+    T *get(EntityId entity)
+    {
+        if (entity >= slots.size() || slots[entity] == EMPTY)
+        {
+            return nullptr;
+        }
+        return &components[slots[entity]];
+    }
+
+    const T *get(EntityId entity) const
+    {
+        if (entity >= slots.size() || slots[entity] == EMPTY)
+        {
+            return nullptr;
+        }
+        return &components[slots[entity]];
+    }
+
+    // replaces the existing component if the entity already has one
+    void add(EntityId entity, T component)
+    {
+        if (entity >= slots.size())
+        {
+            slots.resize(entity + 1, EMPTY);
+        }
+        if (slots[entity] != EMPTY)
+        {
+            components[slots[entity]] = std::move(component);
+            return;
+        }
+        slots[entity] = components.size();
+        components.push_back(std::move(component));
+        owners.push_back(entity);
+    }
+
+    // swap the last component into the hole so the array stays packed
+    void remove(EntityId entity)
+    {
+        if (entity >= slots.size() || slots[entity] == EMPTY)
+        {
+            return;
+        }
+        std::uint32_t slot = slots[entity];
+        std::uint32_t last = components.size() - 1;
+        if (slot != last)
+        {
+            components[slot] = std::move(components[last]);
+            owners[slot] = owners[last];
+            slots[owners[slot]] = slot;
+        }
+        components.pop_back();
+        owners.pop_back();
+        slots[entity] = EMPTY;
+    }
+
+    void reserve(std::size_t entities)
+    {
+        components.reserve(entities);
+        owners.reserve(entities);
+        slots.reserve(entities);
+    }
+
+    // keeps the capacity so the next floor reuses the same storage
+    void clear()
+    {
+        components.clear();
+        owners.clear();
+        slots.clear();
+    }
+
+    // appends the owners and components in slot order, see EntityManager::pageOut
+    void save(std::string &out) const
+    {
+        std::uint32_t count = components.size();
+        out.append(reinterpret_cast<const char *>(&count), sizeof(count));
+        out.append(reinterpret_cast<const char *>(owners.data()), count * sizeof(EntityId));
+        saveComponents(out, std::is_trivially_copyable<T>());
+    }
+
+    // replaces the pool with what save wrote at in and returns the end of it
+    const char *load(const char *in)
+    {
+        clear();
+        std::uint32_t count;
+        std::memcpy(&count, in, sizeof(count));
+        in += sizeof(count);
+        for (std::uint32_t slot = 0; slot < count; slot++, in += sizeof(EntityId))
+        {
+            EntityId owner;
+            std::memcpy(&owner, in, sizeof(owner));
+            owners.push_back(owner);
+            if (owner >= slots.size())
+            {
+                slots.resize(owner + 1, EMPTY);
+            }
+            slots[owner] = slot;
+        }
+        return loadComponents(in, count, std::is_trivially_copyable<T>());
+    }
+
+    std::size_t size() const { return components.size(); }
+    T &at(std::size_t slot) { return components[slot]; }
+    EntityId owner(std::size_t slot) const { return owners[slot]; }
+};
+
+template <typename T>
+const std::uint32_t ComponentPool<T>::EMPTY;
+
+#endif // COMPONENT_POOL_H
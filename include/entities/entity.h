@@ -1,54 +1,44 @@
 #ifndef ENTITY_H
 #define ENTITY_H
 
-#include <iostream>
-#include <string>
-#include <unordered_map>
-#include <memory>
-#include <typeinfo>
-#include <typeindex>
-#include <string>
-#include <cassert>
+#include <cstdint>
+#include "entities/component_pool.h"
 #include "components/components.h"
 
-class Component;
+class EntityManager;
 
+// Lightweight handle to an entity; the components themselves live in the owning EntityManager.
+// Component pointers returned by getComponent are invalidated when a component of the
+// same type is added to or removed from any entity of that manager.
 class Entity
 {
-    std::unordered_map<std::type_index, std::shared_ptr<Component>> components;
+    EntityManager *manager;
+    EntityId entityId;
 
 public:
+    Entity() : manager{nullptr}, entityId{0} {};
+    Entity(EntityManager *manager, EntityId id) : manager{manager}, entityId{id} {};
+
+    EntityId id() const { return entityId; }
+    explicit operator bool() const { return manager != nullptr; }
+    bool operator==(const Entity &other) const { return manager == other.manager && entityId == other.entityId; }
+    bool operator!=(const Entity &other) const { return !(*this == other); }
+
     template <typename T>
-    void addComponent(std::shared_ptr<T> component);
+    void addComponent(T component) const;
 
     template <typename T>
-    std::shared_ptr<T> getComponent();
+    T *getComponent() const;
 
     template <typename T>
-    void removeComponent();
-};
+    void removeComponent() const;
 
-template <typename T>
-void Entity::addComponent(std::shared_ptr<T> component)
-{
-    components[typeid(T)] = component;
-}
+    // a single bit test against the entity's signature
+    template <typename T>
+    bool hasComponent() const;
+};
 
-template <typename T>
-std::shared_ptr<T> Entity::getComponent()
-{
-    auto it = components.find(typeid(T));
-    if (it != components.end())
-    {
-        return std::static_pointer_cast<T>(it->second);
-    }
-    return nullptr;
-}
-
-template <typename T>
-void Entity::removeComponent()
-{
-    components.erase(typeid(T));
-}
+// the template definitions need the complete EntityManager
+#include "entities/entity_manager.h"
 
-#endif
\ No newline at end of file
+#endif
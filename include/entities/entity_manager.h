@@ -1,27 +1,303 @@
 #ifndef ENTITY_MANAGER_H
 #define ENTITY_MANAGER_H
 
-#include <vector>
+#include <array>
 #include <memory>
+#include <string>
+#include <tuple>
 #include <utility>
 #include <algorithm>
 #include "entities/entity.h"
+#include "entities/component_pool.h"
+#include "entities/signature.h"
 #include "components/position_component.h"
+#include "map/floor_map.h"
 
-class Entity;
-class Component;
-class PositionComponent;
+template <typename List>
+struct PoolTuple;
+
+template <typename... Components>
+struct PoolTuple<ComponentList<Components...>>
+{
+    using type = std::tuple<ComponentPool<Components>...>;
+};
+
+// A floor moved out of its EntityManager: every entity and component as packed bytes, and the
+// map it is laid out on. A few kilobytes for a typical floor, whatever the size of the map.
+struct FloorPage
+{
+    std::shared_ptr<const FloorMap> map;
+    std::string bytes;
+};
 
 class EntityManager
 {
 private:
-    std::vector<std::shared_ptr<Entity>> entities;
+    StorageVector<EntityId> entities;     // live entities in creation order
+    PoolTuple<AllComponents>::type pools; // pool of component T is at index ComponentId<T>
+    StorageVector<Signature> signatures;  // which components each entity id currently has
+    EntityId nextId = 0;
+
+    std::shared_ptr<const FloorMap> map;
+    int height = 0; // of the map, kept here for cellIndex
+    int width = 0;
+
+    // Spatial index: every entity with a PositionComponent is linked into the list of its cell.
+    // cellHeads holds the first entity of each cell of the map, nextInCell chains the rest
+    StorageVector<EntityId> cellHeads;
+    StorageVector<EntityId> nextInCell;
+    Bitboard occupancy; // set for every cell with at least one entity in it
+
+    template <typename T>
+    ComponentPool<T> &pool();
+
+    template <std::size_t... Ids>
+    void removeComponents(EntityId entity, Signature signature, std::index_sequence<Ids...>);
+
+    template <std::size_t... Ids>
+    void clearPools(std::index_sequence<Ids...>);
+
+    template <std::size_t... Ids>
+    void copyComponents(EntityId entity, const EntityManager &from, EntityId source, Signature signature, std::index_sequence<Ids...>);
+
+    template <std::size_t... Ids>
+    void reservePools(std::size_t capacity, std::index_sequence<Ids...>);
+
+    template <std::size_t... Ids>
+    void savePools(std::string &out, std::index_sequence<Ids...>) const;
+
+    template <std::size_t... Ids>
+    const char *loadPools(const char *in, std::index_sequence<Ids...>);
+
+    int cellIndex(int row, int col) const;
+    void link(EntityId entity, int row, int col);
+    void unlink(EntityId entity, int row, int col);
 
 public:
-    std::shared_ptr<Entity> createEntity();
-    void removeEntity(std::shared_ptr<Entity> entity);
-    std::shared_ptr<Entity> getEntity(int row, int col);
-    std::vector<std::shared_ptr<Entity>> &getEntities();
+    static const EntityId NO_ENTITY = UINT32_MAX;
+
+    // laid out on boardMap()
+    EntityManager();
+    // entity handles point back at their manager, so it must stay put
+    EntityManager(const EntityManager &) = delete;
+    EntityManager &operator=(const EntityManager &) = delete;
+
+    Entity createEntity();
+    // Creates an entity holding a copy of every component of prototype, an entity of another
+    // manager, except its position. One pool append per component, no per-type dispatch at runtime.
+    Entity instantiate(const EntityManager &prototypes, EntityId prototype);
+    void removeEntity(Entity entity);
+    Entity getEntity(int row, int col);
+    // the 8 cells around (row, col) in row-major order, null handles for empty cells
+    std::array<Entity, 8> getNeighbours(int row, int col);
+    // adds or moves the entity's PositionComponent and keeps the spatial index in sync
+    void setPosition(Entity entity, int row, int col);
+    // checks the spatial index against the stored positions, for debug builds
+    bool validateSpatialIndex();
+    // one bit per cell, kept in step with the spatial index
+    const Bitboard &getOccupancy() const;
+    // Drops every entity and lays the spatial index out for map. The index is only reallocated
+    // when the map is a different size.
+    void setMap(std::shared_ptr<const FloorMap> map);
+    const FloorMap &getMap() const;
+    const StorageVector<EntityId> &getEntities() const;
+    // Drops every entity but keeps all storage allocated, so regenerating a floor after a clear
+    // does not touch the heap unless it holds more entities than any floor before it
+    void clear();
+    // grows every pool up front so a typical floor never reallocates while it is being spawned
+    void reserve(std::size_t capacity);
+    // Writes the floor to page. pageIn restores it exactly, down to the order of every pool and
+    // cell list, so a paged floor plays out the same as one that never left memory.
+    void pageOut(FloorPage &page) const;
+    void pageIn(const FloorPage &page);
+    // Exchanges the contents of two managers in constant time. Handles obtained before the swap
+    // keep pointing at the same manager object and so see the other contents afterwards.
+    void swap(EntityManager &other);
+
+    template <typename T>
+    void addComponent(EntityId entity, T component);
+
+    template <typename T>
+    T *getComponent(EntityId entity);
+
+    template <typename T>
+    bool hasComponent(EntityId entity) const;
+
+    bool hasComponents(EntityId entity, Signature required) const;
+
+    template <typename T>
+    void removeComponent(EntityId entity);
+
+    // Calls function(entity, T&, Others&...) for every entity whose signature holds all the listed
+    // components, scanning the packed array of T. Components must not be added or removed while iterating.
+    template <typename T, typename... Others, typename Function>
+    void forEach(Function function);
+
+    // Calls function(entity) for every entity standing in rows top to bottom and columns left to
+    // right, clamped to the map, in row-major order. Reads the occupancy mask a word at a time, so
+    // it costs the size of the rectangle and what stands in it, however many entities the floor
+    // holds. Entities must not be moved while iterating.
+    template <typename Function>
+    void forEachIn(int top, int left, int bottom, int right, Function function);
 };
 
-#endif
\ No newline at end of file
+// positions must go through the spatial index
+template <>
+void EntityManager::addComponent<PositionComponent>(EntityId entity, PositionComponent component);
+
+template <>
+void EntityManager::removeComponent<PositionComponent>(EntityId entity);
+
+template <typename T>
+ComponentPool<T> &EntityManager::pool()
+{
+    return std::get<ComponentId<T>::value>(pools);
+}
+
+template <std::size_t... Ids>
+void EntityManager::removeComponents(EntityId entity, Signature signature, std::index_sequence<Ids...>)
+{
+    int expand[] = {0, ((signature >> Ids) & 1 ? (std::get<Ids>(pools).remove(entity), 0) : 0)...};
+    (void)expand;
+}
+
+template <std::size_t... Ids>
+void EntityManager::copyComponents(EntityId entity, const EntityManager &from, EntityId source, Signature signature, std::index_sequence<Ids...>)
+{
+    int expand[] = {0, ((signature >> Ids) & 1 ? (std::get<Ids>(pools).add(entity, *std::get<Ids>(from.pools).get(source)), 0) : 0)...};
+    (void)expand;
+}
+
+template <std::size_t... Ids>
+void EntityManager::clearPools(std::index_sequence<Ids...>)
+{
+    int expand[] = {0, (std::get<Ids>(pools).clear(), 0)...};
+    (void)expand;
+}
+
+template <std::size_t... Ids>
+void EntityManager::reservePools(std::size_t capacity, std::index_sequence<Ids...>)
+{
+    int expand[] = {0, (std::get<Ids>(pools).reserve(capacity), 0)...};
+    (void)expand;
+}
+
+template <std::size_t... Ids>
+void EntityManager::savePools(std::string &out, std::index_sequence<Ids...>) const
+{
+    int expand[] = {0, (std::get<Ids>(pools).save(out), 0)...};
+    (void)expand;
+}
+
+template <std::size_t... Ids>
+const char *EntityManager::loadPools(const char *in, std::index_sequence<Ids...>)
+{
+    int expand[] = {0, (in = std::get<Ids>(pools).load(in), 0)...};
+    (void)expand;
+    return in;
+}
+
+inline bool EntityManager::hasComponents(EntityId entity, Signature required) const
+{
+    return entity < signatures.size() && (signatures[entity] & required) == required;
+}
+
+template <typename T>
+bool EntityManager::hasComponent(EntityId entity) const
+{
+    return hasComponents(entity, SignatureOf<T>::value);
+}
+
+template <typename T>
+void EntityManager::addComponent(EntityId entity, T component)
+{
+    pool<T>().add(entity, std::move(component));
+    signatures[entity] |= SignatureOf<T>::value;
+}
+
+template <typename T>
+T *EntityManager::getComponent(EntityId entity)
+{
+    if (!hasComponent<T>(entity))
+    {
+        return nullptr;
+    }
+    return pool<T>().get(entity);
+}
+
+template <typename T>
+void EntityManager::removeComponent(EntityId entity)
+{
+    pool<T>().remove(entity);
+    signatures[entity] &= ~SignatureOf<T>::value;
+}
+
+template <typename T, typename... Others, typename Function>
+void EntityManager::forEach(Function function)
+{
+    const Signature required = SignatureOf<T, Others...>::value;
+    ComponentPool<T> &primary = pool<T>();
+    for (std::size_t slot = 0; slot < primary.size(); slot++)
+    {
+        EntityId id = primary.owner(slot);
+        if ((signatures[id] & required) != required)
+        {
+            continue;
+        }
+        function(Entity{this, id}, primary.at(slot), *pool<Others>().get(id)...);
+    }
+}
+
+template <typename Function>
+void EntityManager::forEachIn(int top, int left, int bottom, int right, Function function)
+{
+    top = std::max(top, 0);
+    left = std::max(left, 0);
+    bottom = std::min(bottom, height - 1);
+    right = std::min(right, width - 1);
+    for (int row = top; row <= bottom; row++)
+    {
+        for (int first = left; first <= right; first += 64)
+        {
+            std::uint64_t bits = occupancy.span(row, first);
+            if (right - first < 63)
+            {
+                bits &= (std::uint64_t(1) << (right - first + 1)) - 1;
+            }
+            for (; bits; bits &= bits - 1)
+            {
+                int col = first + __builtin_ctzll(bits);
+                for (EntityId id = cellHeads[row * width + col]; id != NO_ENTITY; id = nextInCell[id])
+                {
+                    function(Entity{this, id});
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+void Entity::addComponent(T component) const
+{
+    manager->addComponent(entityId, std::move(component));
+}
+
+template <typename T>
+T *Entity::getComponent() const
+{
+    return manager->getComponent<T>(entityId);
+}
+
+template <typename T>
+void Entity::removeComponent() const
+{
+    manager->removeComponent<T>(entityId);
+}
+
+template <typename T>
+bool Entity::hasComponent() const
+{
+    return manager->hasComponent<T>(entityId);
+}
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef SIGNATURE_H
+#define SIGNATURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "components/components.h"
+
+// one bit per entry of AllComponents
+using Signature = std::uint32_t;
+
+template <typename T, typename List>
+struct IndexOf;
+
+template <typename T, typename... Rest>
+struct IndexOf<T, ComponentList<T, Rest...>> : std::integral_constant<std::size_t, 0>
+{};
+
+template <typename T, typename First, typename... Rest>
+struct IndexOf<T, ComponentList<First, Rest...>>
+    : std::integral_constant<std::size_t, 1 + IndexOf<T, ComponentList<Rest...>>::value>
+{};
+
+template <typename List>
+struct ListSize;
+
+template <typename... Components>
+struct ListSize<ComponentList<Components...>> : std::integral_constant<std::size_t, sizeof...(Components)>
+{};
+
+const std::size_t NUM_COMPONENTS = ListSize<AllComponents>::value;
+static_assert(NUM_COMPONENTS <= sizeof(Signature) * 8, "Signature has no bit left for a new component");
+
+// dense compile-time id of a component, usable as a tuple index or a signature bit
+template <typename T>
+struct ComponentId : IndexOf<T, AllComponents>
+{};
+
+template <typename... Components>
+struct SignatureOf;
+
+template <>
+struct SignatureOf<> : std::integral_constant<Signature, 0>
+{};
+
+template <typename First, typename... Rest>
+struct SignatureOf<First, Rest...>
+    : std::integral_constant<Signature, (Signature(1) << ComponentId<First>::value) | SignatureOf<Rest...>::value>
+{};
+
+#endif // SIGNATURE_H
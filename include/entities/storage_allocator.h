@@ -0,0 +1,59 @@
+#ifndef STORAGE_ALLOCATOR_H
+#define STORAGE_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Process-wide counters for every heap block taken by entity and component storage
+class StorageStats
+{
+    static std::atomic<std::size_t> allocationCount;
+    static std::atomic<std::size_t> deallocationCount;
+    static std::atomic<std::size_t> allocatedBytes;
+
+    template <typename T>
+    friend class StorageAllocator;
+
+public:
+    static std::size_t allocations() { return allocationCount.load(std::memory_order_relaxed); }
+    static std::size_t deallocations() { return deallocationCount.load(std::memory_order_relaxed); }
+    static std::size_t bytes() { return allocatedBytes.load(std::memory_order_relaxed); }
+};
+
+// std::allocator that reports to StorageStats, used by the EntityManager's arrays
+template <typename T>
+class StorageAllocator
+{
+public:
+    using value_type = T;
+
+    StorageAllocator() = default;
+    template <typename U>
+    StorageAllocator(const StorageAllocator<U> &) {}
+
+    T *allocate(std::size_t n)
+    {
+        StorageStats::allocationCount.fetch_add(1, std::memory_order_relaxed);
+        StorageStats::allocatedBytes.fetch_add(n * sizeof(T), std::memory_order_relaxed);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n)
+    {
+        StorageStats::deallocationCount.fetch_add(1, std::memory_order_relaxed);
+        std::allocator<T>().deallocate(p, n);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const StorageAllocator<T> &, const StorageAllocator<U> &) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const StorageAllocator<T> &, const StorageAllocator<U> &) { return false; }
+
+template <typename T>
+using StorageVector = std::vector<T, StorageAllocator<T>>;
+
+#endif // STORAGE_ALLOCATOR_H
@@ -0,0 +1,31 @@
+#ifndef FLOOR_CACHE_H
+#define FLOOR_CACHE_H
+
+#include <string>
+#include <vector>
+#include "constants/kinds.h"
+#include "entities/entity_manager.h"
+
+// Untouched copies of the floors generated for one seed and race, so restarting with the
+// same seed restores them instead of generating them again. Only floors that were actually
+// reached are stored, paged out so a game of hundreds of floors keeps a few kilobytes each.
+class FloorCache
+{
+    int seed = 0;
+    Race race = Race::HUMAN;
+    std::vector<FloorPage> floors; // keep their buffers between games, the next store reuses them
+    std::vector<bool> stored;      // which floors hold a copy for this seed and race
+
+public:
+    FloorCache() = default;
+    FloorCache(const FloorCache &) = delete;
+    FloorCache &operator=(const FloorCache &) = delete;
+
+    // drops the stored floors unless they were generated from this seed and race for a game this long
+    void use(int seed, Race race, int floorCount);
+    // the stored copy of floor, or nullptr if it has not been generated yet
+    const FloorPage *find(int floor) const;
+    void store(int floor, const EntityManager &generated);
+};
+
+#endif // FLOOR_CACHE_H
@@ -0,0 +1,23 @@
+#ifndef FNV_H
+#define FNV_H
+
+#include <cstddef>
+#include <cstdint>
+
+// FNV-1a over bytes, for the state hash and the fingerprints replay logs keep of their inputs.
+// Not meant to resist anyone crafting collisions.
+const std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+// continues hash over size bytes at data
+inline std::uint64_t fnv1a(const void *data, std::size_t size, std::uint64_t hash = FNV_OFFSET)
+{
+    const unsigned char *bytes = static_cast<const unsigned char *>(data);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+#endif // FNV_H
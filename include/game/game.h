@@ -0,0 +1,88 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "constants/constants.h"
+#include "entities/entity_manager.h"
+#include "game/game_context.h"
+#include "systems/combat_system.h"
+#include "systems/spawn_system.h"
+#include "systems/input_system.h"
+#include "systems/movement_system.h"
+#include "systems/potion_system.h"
+#include "systems/item_system.h"
+#include "systems/vision_system.h"
+
+// outcome of one game, kept up to date while it is played
+struct GameStats
+{
+    int floor = 1; // floor the game ended on, counted from 1
+    float gold = 0;
+    int turns = 0;
+    bool won = false;
+    std::string causeOfDeath; // empty while the player is alive
+};
+
+// Owns the floors and runs the system pipeline one turn at a time. It does no terminal I/O,
+// so the interactive loop and the headless runner drive exactly the same code.
+class Game
+{
+    GameContext context; // declared first, the systems hold on to it
+    SpawnSystem spawnSystem;
+    CombatSystem combatSystem;
+    PotionSystem potionSystem;
+    ItemSystem itemSystem;
+    InputSystem inputSystem;
+    MovementSystem movementSystem;
+    VisionSystem visionSystem;
+
+    EntityManager entityManager; // the floor being played, the others are not kept in memory
+    std::shared_ptr<const FloorFile> floorFile;
+    int floorCount;
+    int floor = 0;
+    Entity player;
+    GameStats stats;
+
+    void updateStats();
+
+public:
+    // Games are floorCount floors long. Floors are read from floorFile when it is set, which has
+    // to hold that many, and generated otherwise.
+    explicit Game(std::shared_ptr<const FloorFile> floorFile = nullptr, int floorCount = NUM_FLOORS);
+    Game(const Game &) = delete;
+    Game &operator=(const Game &) = delete;
+
+    // starts a new game; the floors are generated from seed
+    void reset(Race race, int seed);
+    // Runs one command through the pipeline. Rejected commands throw like the systems do
+    // and are not counted as turns.
+    void turn(std::string &input);
+
+    bool isOver() const;
+    bool isWon() const;
+    Entity getPlayer() const;
+    int getFloor() const;
+    int getFloorCount() const;
+    EntityManager &currentFloor();
+    GameContext &getContext();
+    const GameStats &getStats() const;
+    // building the next floor on a worker thread while this one is played, on by default
+    void setPrefetch(bool enabled);
+    // hostile enemies chase the player instead of wandering, off by default
+    void setChase(bool enabled);
+    // only enemies within radius rows and columns of the player move, 0 for all of them
+    void setActiveRadius(int radius);
+    // keeps track of what the player sees and remembers of each floor, off by default
+    void setFog(bool enabled);
+    const VisionSystem &getVision() const;
+    // stairs taken by this Game over all its games
+    const TransitionStats &getTransitionStats() const;
+    // FNV-1a over the floor number, the turn count and every entity of the floor the player is on;
+    // two runs that ended in the same state hash the same
+    std::uint64_t stateHash();
+};
+
+#endif // GAME_H
@@ -0,0 +1,37 @@
+#ifndef GAME_CONTEXT_H
+#define GAME_CONTEXT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "game/rng.h"
+#include "constants/kinds.h"
+
+// One random stream per consumer of a game seed. Floors are generated from their own
+// FLOOR stream, so a floor comes out the same however the game before it was played.
+enum RngStream : std::uint64_t
+{
+    GAME_STREAM,
+    MOVEMENT_STREAM,
+    COMBAT_STREAM,
+    FLOOR_STREAM,
+    POLICY_STREAM,
+};
+
+// The mutable state the systems of one game share. Every game owns its own context,
+// so games running on different threads never touch the same data.
+struct GameContext
+{
+    std::vector<std::string> actionMessage; // what happened this turn, cleared once it is shown
+    std::uint8_t seenPotions = 0;           // bit per PotionKind the player has drunk
+    bool merchantHostile = false;           // set once the player attacks a merchant
+    EnemyKind lastAttacker = EnemyKind::COUNT; // enemy that last dealt damage to the player, COUNT for none
+    Rng rng;         // game level choices such as the barrier suit floor
+    Rng movementRng; // enemy movement
+    Rng combatRng;   // enemy hits and misses
+
+    // back to the state of a new game
+    void reset(std::uint64_t seed);
+};
+
+#endif // GAME_CONTEXT_H
@@ -0,0 +1,42 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <string>
+#include <vector>
+#include "game/rng.h"
+
+class Game;
+
+// Chooses the commands of a game that has no human at the keyboard
+class Policy
+{
+public:
+    virtual ~Policy() = default;
+    // a command in the same form the interactive loop reads, e.g. "no", "a we" or "u se";
+    // an empty command ends the game
+    virtual std::string nextCommand(Game &game) = 0;
+};
+
+// Takes the stairs when they are next to the player, otherwise attacks an adjacent enemy,
+// picks up adjacent items or drinks adjacent potions, and wanders at random when there is nothing to do
+class RandomPolicy : public Policy
+{
+    Rng rng;
+
+public:
+    explicit RandomPolicy(unsigned seed);
+    std::string nextCommand(Game &game) override;
+};
+
+// Plays a fixed list of commands in order and ends the game when they run out
+class ScriptPolicy : public Policy
+{
+    const std::vector<std::string> &commands;
+    std::size_t next = 0;
+
+public:
+    explicit ScriptPolicy(const std::vector<std::string> &commands);
+    std::string nextCommand(Game &game) override;
+};
+
+#endif // POLICY_H
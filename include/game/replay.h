@@ -0,0 +1,61 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "constants/constants.h"
+#include "constants/kinds.h"
+
+struct FloorFile;
+
+// What a session was played with besides its commands. The game data and floor file are too big
+// to keep, a log holds their hashes so a replay can tell it was handed different ones.
+struct SessionSettings
+{
+    int seed = 0;
+    int floors = NUM_FLOORS;
+    bool chase = false;
+    int activeRadius = 0;
+    std::uint64_t dataHash = 0;
+    std::uint64_t floorFileHash = 0; // 0 for generated floors
+};
+
+// Session logs written by --record and played back by --replay. A log starts with "CC3K", a
+// format version byte and a header, all numbers little-endian:
+//   int32 seed, uint32 floors, uint8 chase, uint32 active radius, uint64 game data hash,
+//   uint64 floor file hash
+// followed by one record per input:
+//   0x00-0x17          a direction command, action * 8 + direction (actions: move, attack, use)
+//   0x20 race          a new game, race is 'h', 'e', 'd' or 'o'
+//   0x21 length bytes  any other command line, at most 255 bytes
+//   0x22 hash          end of the session and the little-endian uint64 state hash it ended in
+class Recorder
+{
+    std::ofstream out;
+
+public:
+    Recorder(const std::string &path, const SessionSettings &settings);
+    void newGame(Race race);
+    void command(const std::string &input);
+    void finish(std::uint64_t stateHash);
+};
+
+struct ReplayResult
+{
+    int games = 0;
+    int commands = 0;
+    std::uint64_t recordedHash = 0;
+    std::uint64_t replayedHash = 0;
+    double seconds = 0;
+
+    bool matches() const { return recordedHash == replayedHash; }
+};
+
+// Replays a log through Game without rendering, as fast as the pipeline runs, with the settings
+// it was recorded with. The floor file and the game data are not part of the log, the same have
+// to be loaded again; the replay throws if they are not.
+ReplayResult replay(const std::string &path, std::shared_ptr<const FloorFile> floorFile);
+
+#endif // REPLAY_H
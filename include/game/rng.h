@@ -0,0 +1,51 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <cstdint>
+
+// PCG32 (pcg-random.org): 64 bits of state and one multiply-add per draw. Generators seeded
+// with the same seed but different streams produce independent sequences, so each subsystem
+// gets its own and a draw in one never shifts the numbers another sees.
+class Rng
+{
+    std::uint64_t state = 0;
+    std::uint64_t increment = 1;
+
+public:
+    using result_type = std::uint32_t;
+
+    Rng() { seed(0, 0); }
+    Rng(std::uint64_t seedValue, std::uint64_t stream) { seed(seedValue, stream); }
+
+    void seed(std::uint64_t seedValue, std::uint64_t stream)
+    {
+        state = 0;
+        increment = (stream << 1) | 1;
+        next();
+        state += seedValue;
+        next();
+    }
+
+    std::uint32_t next()
+    {
+        std::uint64_t old = state;
+        state = old * 6364136223846793005ULL + increment;
+        std::uint32_t xorshifted = ((old >> 18) ^ old) >> 27;
+        std::uint32_t rotation = old >> 59;
+        return (xorshifted >> rotation) | (xorshifted << ((-rotation) & 31));
+    }
+
+    // Uniform in [0, bound) by multiply-shift instead of a division. The bias is below
+    // bound / 2^32, which is nothing for the handful of choices the game makes.
+    std::uint32_t below(std::uint32_t bound)
+    {
+        return (std::uint64_t(next()) * bound) >> 32;
+    }
+
+    // usable wherever the standard library wants a uniform random bit generator
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()() { return next(); }
+};
+
+#endif // RNG_H
@@ -0,0 +1,41 @@
+#ifndef RUNNER_H
+#define RUNNER_H
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "constants/constants.h"
+#include "constants/kinds.h"
+
+struct FloorFile;
+class Game;
+class Policy;
+
+struct RunnerOptions
+{
+    int games = 0;
+    int threads = std::max(1, int(std::thread::hardware_concurrency())); // one per core by default
+    int seed = 0; // game i is played with seed + i
+    std::shared_ptr<const FloorFile> floorFile; // shared by every worker, floors are generated when null
+    int floors = NUM_FLOORS;                    // of every game
+    Race race = Race::HUMAN;
+    bool prefetch = false; // build the next floor in the background, see SpawnSystem
+    bool chase = false;   // hostile enemies chase the player, see MovementSystem
+    bool fog = false;     // track what the player sees, for measuring it, see VisionSystem
+    int activeRadius = 0; // only enemies this close to the player move, 0 for all, see MovementSystem
+    std::vector<std::string> script; // commands every game plays, games use a RandomPolicy when empty
+};
+
+// reads one command per line, skipping blank lines and stopping at "q"
+std::vector<std::string> readScript(const std::string &path);
+
+// plays one game with commands from policy until it ends or runs out of commands
+void playGame(Game &game, Policy &policy, Race race, int seed);
+
+// Plays options.games complete games without a display, spread over options.threads workers that
+// each own a Game, then prints one stats line per game in order and a summary
+void runGames(const RunnerOptions &options);
+
+#endif // RUNNER_H
@@ -0,0 +1,42 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Runs a batch of independent tasks on a fixed number of threads. Every worker owns a deque:
+// it takes tasks from the front of its own and, once that is empty, steals from the back of
+// the others, so a worker that drew short games keeps helping the ones that drew long ones.
+class WorkStealingPool
+{
+public:
+    // a task is told which worker runs it, so it can use that worker's own storage
+    using Task = std::function<void(unsigned worker)>;
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    unsigned nextQueue = 0;
+
+    bool take(unsigned worker, Task &task);
+    void work(unsigned worker);
+
+public:
+    explicit WorkStealingPool(unsigned workers);
+
+    unsigned size() const;
+    // deals tasks out round-robin; only call it while the pool is not running
+    void submit(Task task);
+    // runs every submitted task and returns once all of them are done, the calling thread is worker 0
+    void run();
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -0,0 +1,134 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "constants/kinds.h"
+
+// Bits of a neighbour mask, in the row-major order EntityManager::getNeighbours uses:
+//   0 1 2
+//   3 . 4
+//   5 6 7
+// Bit d is Direction d, the neighbour at DIRECTION_ROW[d], DIRECTION_COL[d].
+
+// One bit per board cell. Every row starts on a fresh 64-bit word, so a row is read a word at a
+// time without masking off the next one. Bits past the last column are always zero.
+class Bitboard
+{
+    int rows = 0;
+    int cols = 0;
+    int stride = 0; // words per row
+    std::vector<std::uint64_t> words;
+    std::size_t population = 0; // set cells, kept up to date so count does not scan a big board
+
+    // bits of (row, col - 1), (row, col) and (row, col + 1) in bits 0 to 2
+    std::uint32_t triple(int row, int col) const;
+
+public:
+    Bitboard() = default;
+    Bitboard(int rows, int cols);
+
+    int height() const { return rows; }
+    int width() const { return cols; }
+
+    // cells off the board read as clear and are ignored when written
+    bool test(int row, int col) const;
+    void set(int row, int col);
+    void reset(int row, int col);
+    void clear();
+    // clears rows first up to last, both included, clamped to the board
+    void clearRows(int first, int last);
+    std::size_t count() const { return population; }
+
+    // the 8 cells around (row, col) as a neighbour mask
+    std::uint8_t neighbours(int row, int col) const;
+    // cells (row, col) up to (row, col + 63) as the bits of a word, lowest first
+    std::uint64_t span(int row, int col) const;
+};
+
+inline bool Bitboard::test(int row, int col) const
+{
+    if (row < 0 || row >= rows || col < 0 || col >= cols)
+    {
+        return false;
+    }
+    return (words[row * stride + (col >> 6)] >> (col & 63)) & 1;
+}
+
+inline void Bitboard::set(int row, int col)
+{
+    if (row < 0 || row >= rows || col < 0 || col >= cols)
+    {
+        return;
+    }
+    std::uint64_t &word = words[row * stride + (col >> 6)];
+    std::uint64_t bit = std::uint64_t(1) << (col & 63);
+    population += !(word & bit);
+    word |= bit;
+}
+
+inline void Bitboard::reset(int row, int col)
+{
+    if (row < 0 || row >= rows || col < 0 || col >= cols)
+    {
+        return;
+    }
+    std::uint64_t &word = words[row * stride + (col >> 6)];
+    std::uint64_t bit = std::uint64_t(1) << (col & 63);
+    population -= !!(word & bit);
+    word &= ~bit;
+}
+
+inline std::uint32_t Bitboard::triple(int row, int col) const
+{
+    if (row < 0 || row >= rows)
+    {
+        return 0;
+    }
+    const std::uint64_t *line = &words[row * stride];
+    int first = col - 1;
+    if (first < 0)
+    {
+        return first < -2 ? 0 : (line[0] << -first) & 7;
+    }
+    int word = first >> 6;
+    int bit = first & 63;
+    if (word >= stride)
+    {
+        return 0;
+    }
+    std::uint64_t bits = line[word] >> bit;
+    if (bit > 61 && word + 1 < stride)
+    {
+        bits |= line[word + 1] << (64 - bit);
+    }
+    return bits & 7;
+}
+
+inline std::uint64_t Bitboard::span(int row, int col) const
+{
+    if (row < 0 || row >= rows || col < 0 || col >= cols)
+    {
+        return 0;
+    }
+    const std::uint64_t *line = &words[row * stride];
+    int word = col >> 6;
+    int bit = col & 63;
+    std::uint64_t bits = line[word] >> bit;
+    if (bit > 0 && word + 1 < stride)
+    {
+        bits |= line[word + 1] << (64 - bit);
+    }
+    return bits;
+}
+
+inline std::uint8_t Bitboard::neighbours(int row, int col) const
+{
+    std::uint32_t above = triple(row - 1, col);
+    std::uint32_t middle = triple(row, col);
+    std::uint32_t below = triple(row + 1, col);
+    return above | (middle & 1) << 3 | (middle >> 2) << 4 | below << 5;
+}
+
+#endif // BITBOARD_H
@@ -0,0 +1,14 @@
+#ifndef FIELD_OF_VIEW_H
+#define FIELD_OF_VIEW_H
+
+#include "map/bitboard.h"
+
+// Sets in visible every cell within radius of (row, col) that has a line of sight to it, by
+// recursive shadowcasting: each of the 8 octants is scanned outwards a row at a time, and an
+// opaque cell narrows the range of slopes the rows behind it are scanned over. Cells are only
+// ever visited when they can be seen, so the cost follows what is in view rather than the size
+// of the map. Opaque cells are seen but block what is behind them, and everything off the map
+// is opaque. Every cell in view is set in both visible and seen, neither is cleared first.
+void castFieldOfView(const Bitboard &transparent, int row, int col, int radius, Bitboard &visible, Bitboard &seen);
+
+#endif // FIELD_OF_VIEW_H
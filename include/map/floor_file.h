@@ -0,0 +1,61 @@
+#ifndef FLOOR_FILE_H
+#define FLOOR_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "map/floor_map.h"
+
+// One entity of a floor file, what its glyph stands for
+struct FloorSpawn
+{
+    enum Kind : std::uint8_t
+    {
+        PLAYER,
+        ENEMY,    // type is an EnemyKind
+        POTION,   // type is a PotionKind
+        TREASURE, // type is the value
+        HOARD,    // type is the value, guarded by a dragon
+        ITEM,     // type is an ItemKind
+    };
+
+    Kind kind;
+    std::uint8_t type;
+    std::uint16_t row;
+    std::uint16_t col;
+    // dragons only: the hoard or barrier suit next to it that it guards
+    std::uint16_t guardRow;
+    std::uint16_t guardCol;
+};
+
+// Every floor of a floor file in one flat array, laid out like RoomTable: the spawns of
+// floor f are spawns[offsets[f]] up to spawns[offsets[f + 1]], in the order of the file.
+// Floors with the same layout share their map, and the stock layout shares boardMap().
+struct FloorFile
+{
+    std::vector<int> offsets{0};
+    std::vector<FloorSpawn> spawns;
+    std::vector<std::shared_ptr<const FloorMap>> maps;
+    std::uint64_t hash = 0; // of the text it was parsed from, replay logs keep it
+
+    int count() const { return offsets.size() - 1; }
+    const std::shared_ptr<const FloorMap> &getMap(int floor) const { return maps[floor]; }
+    const FloorSpawn *begin(int floor) const { return spawns.data() + offsets[floor]; }
+    const FloorSpawn *end(int floor) const { return spawns.data() + offsets[floor + 1]; }
+};
+
+// Parses and validates floors, throws "source:line:column: what is wrong" as a string. Floors
+// are separated by blank lines or, in a file without any, follow each other back to back, each
+// ending with the line that repeats its top wall. A floor is at least three lines, every line as
+// long as its top wall, and neither side may be longer than MAX_FLOOR_SIZE. The layout is made of
+// walls, doors, passages, room floor and the void, and an entity glyph stands on room floor,
+// so not in the outer rows or columns.
+// Every floor needs exactly one player and every dragon a hoard or barrier suit of its own
+// next to it.
+FloorFile parseFloorFile(const char *text, std::size_t size, const std::string &source);
+// maps the file into memory and parses it
+FloorFile loadFloorFile(const std::string &path);
+
+#endif // FLOOR_FILE_H
@@ -0,0 +1,47 @@
+#ifndef FLOOR_MAP_H
+#define FLOOR_MAP_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "map/bitboard.h"
+#include "map/rooms.h"
+
+// The layout of a floor and the masks derived from it. A map never changes once built, so
+// floors with the same layout share one.
+class FloorMap
+{
+    int height;
+    int width;
+    std::vector<std::string> layout;
+    Bitboard playerCells;
+    Bitboard enemyCells;
+    Bitboard floorCells;
+    // found the first time they are asked for, most maps of floor files never are
+    mutable std::once_flag roomsFound;
+    mutable RoomTable roomTable;
+
+public:
+    // every line of the layout has to be equally long
+    explicit FloorMap(std::vector<std::string> layout);
+
+    int getHeight() const { return height; }
+    int getWidth() const { return width; }
+    const std::vector<std::string> &getLayout() const { return layout; }
+    char tile(int row, int col) const { return layout[row][col]; }
+
+    // anything but walls and the void: room floor, doors and passages
+    const Bitboard &playerWalkable() const { return playerCells; }
+    // what the player can walk on except doors, enemies never leave their room through one
+    const Bitboard &enemyWalkable() const { return enemyCells; }
+    // room floor, where entities are spawned
+    const Bitboard &roomFloor() const { return floorCells; }
+    // the rooms of this layout, see findRooms; safe to call from any thread
+    const RoomTable &rooms() const;
+};
+
+// BOARD, the map of every generated floor, built the first time it is asked for
+const std::shared_ptr<const FloorMap> &boardMap();
+
+#endif // FLOOR_MAP_H
@@ -0,0 +1,47 @@
+#ifndef FLOW_FIELD_H
+#define FLOW_FIELD_H
+
+#include <cstdint>
+#include <vector>
+#include "map/bitboard.h"
+
+// Steps from every reachable cell to one target over the walkable cells of a map, moving like
+// the entities do in any of the 8 directions. Every step costs the same, so a breadth-first
+// search gives the same distances Dijkstra would. Any number of walkers then pick their next
+// step with one lookup per neighbour instead of a search each.
+class FlowField
+{
+    const Bitboard *walkable = nullptr;
+    int targetRow = -1;
+    int targetCol = -1;
+    std::uint32_t range = 0;
+    int width = 0;
+
+    // A distance is only valid where its stamp is the current generation, so starting a new
+    // search does not have to clear a million cells. Both sit side by side, a visit is one load.
+    struct Step
+    {
+        std::uint32_t stamp;
+        std::uint32_t distance;
+    };
+    std::vector<Step> steps;
+    std::uint32_t generation = 0;
+    std::vector<std::uint32_t> frontier; // row << 16 | col, reused by every search
+
+public:
+    static const std::uint32_t UNREACHABLE = UINT32_MAX;
+
+    // Points the field at (row, col), which itself need not be walkable, out to maxDistance steps.
+    // Searches again only when the target, range or walkable mask is not the one of the last search,
+    // and returns whether it did. The mask has to outlive the field or the next call, maps never
+    // change once built. The search touches at most (2 * maxDistance + 1)^2 cells, whatever the
+    // size of the map.
+    bool update(const Bitboard &walkable, int row, int col, std::uint32_t maxDistance);
+    // steps from (row, col) to the target, UNREACHABLE off the field, out of range or walled off
+    std::uint32_t distanceAt(int row, int col) const;
+    // neighbour mask of the cells around (row, col) that are closest to the target, empty when
+    // none of them is closer than (row, col) itself
+    std::uint8_t closerNeighbours(int row, int col, std::uint8_t candidates) const;
+};
+
+#endif // FLOW_FIELD_H
@@ -0,0 +1,49 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class Rng;
+struct RoomTable;
+
+// Free cells of every room as swap-remove arrays, so a spawn takes a random free cell in
+// constant time and never has to probe for an empty one. A room that fills up simply stops
+// being chosen, and take throws once no room has a cell left.
+class Placement
+{
+    using Cell = std::pair<int, int>;
+
+    int width;
+    // Cells of every room laid out like RoomTable, the first freeCount[room] of each room still
+    // free. Taking a cell swaps it behind the free ones, and reset undoes the swaps in reverse so
+    // every floor starts from the same order whatever the floor before it took.
+    std::vector<int> offsets;
+    std::vector<Cell> cells;
+    std::vector<std::size_t> freeCount;
+    std::vector<std::pair<int, int>> taken; // room and slot of every swap since the last reset
+    std::vector<int> roomOf;                // room of each board cell, -1 outside the rooms
+    std::vector<int> slotOf;                // index of each board cell within its room
+    std::vector<int> candidates;            // scratch for take, kept to avoid reallocating it
+
+    void swapCells(int room, int a, int b);
+    void remove(int room, int slot);
+
+public:
+    Placement(const RoomTable &rooms, int height, int width);
+
+    // frees every cell again, in time proportional to the cells taken
+    void reset();
+    int roomCount() const;
+    // room holding (row, col), -1 if it is not a room cell
+    int roomAt(int row, int col) const;
+    std::size_t freeCells(int room) const;
+    // Takes a random free cell from a random room that still has one, other than excludedRoom.
+    // Rooms are equally likely whatever their size, as are the free cells within a room.
+    Cell take(Rng &rng, int excludedRoom = -1);
+    // marks a cell as taken that was filled some other way, like a dragon next to its hoard
+    void claim(int row, int col);
+};
+
+#endif // PLACEMENT_H
@@ -0,0 +1,25 @@
+#ifndef ROOMS_H
+#define ROOMS_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Rooms of a floor layout in one flat array: the cells of room r are
+// cells[offsets[r]] up to cells[offsets[r + 1]], in row-major order
+struct RoomTable
+{
+    std::vector<int> offsets{0};
+    std::vector<std::pair<int, int>> cells;
+
+    int count() const { return offsets.size() - 1; }
+    int size(int room) const { return offsets[room + 1] - offsets[room]; }
+    const std::pair<int, int> &cell(int room, int index) const { return cells[offsets[room] + index]; }
+};
+
+// Flood fills the layout into rooms. Room cells are anything but walls, doors, passages and the
+// void, so entity glyphs in a saved floor count as the floor they stand on. Rooms are numbered
+// by their first cell in row-major order.
+RoomTable findRooms(const std::vector<std::string> &layout);
+
+#endif // ROOMS_H
@@ -3,24 +3,27 @@
 
 #include <string>
 #include <memory>
+#include "constants/kinds.h"
 
 using namespace std;
 
 class Entity;
 class EntityManager;
+struct GameContext;
 
 class CombatSystem
 {
-    bool merchantHostile = false;
-    void lifesteal(Entity &, int);
-    void goldsteal(Entity &, Entity &);
-    void attack(Entity &, Entity &);
-    bool checkDeath(Entity &);
-    void enemies_attack(EntityManager &, Entity &);
-    void battle(EntityManager &, shared_ptr<Entity>, const string &);
+    GameContext &context;
+    void lifesteal(Entity, int);
+    void goldsteal(Entity, Entity);
+    void attack(Entity, Entity);
+    bool checkDeath(Entity);
+    void enemies_attack(EntityManager &, Entity);
+    void battle(EntityManager &, Entity, Direction);
 
 public:
-    void update(EntityManager &, shared_ptr<Entity>);
+    explicit CombatSystem(GameContext &context);
+    void update(EntityManager &, Entity);
 };
 
 #endif
\ No newline at end of file
@@ -6,18 +6,57 @@
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <vector>
 
 using namespace std;
 
 class EntityManager;
 class Entity;
+class VisionSystem;
+struct GameContext;
 
+// Renders the floor as a diff against the previous frame: only cells whose glyph changed are
+// re-emitted, using cursor-positioning escapes and one colour escape per run of equal colour.
+// The whole frame is composed into frameBuffer and handed to the terminal in one write.
 class DisplaySystem
 {
-    void outputColor(char c);
+    GameContext &context;
+    const VisionSystem *vision = nullptr;
+    std::vector<char> previousFrame, currentFrame;
+    std::string frameBuffer; // reused between frames, reserved once
+    bool fullRedraw = true;
+    bool showFrameStats = false;
+    std::size_t frameBytes = 0;
+    std::size_t totalBytes = 0;
+
+    // the part of the map on screen, all of it unless it is bigger than the stock board
+    int viewRow = 0, viewCol = 0;
+    int viewHeight = 0, viewWidth = 0;
+    int previousWidth = 0; // of previousFrame
+
+    // terminal state while a frame is being emitted
+    const char *activeColor = nullptr;
+    int cursorRow = -1, cursorCol = -1;
+
+    static const char *colorOf(char c);
+    void emit(const char *text);
+    void emit(const std::string &text);
+    void emit(int number);
+    void flush();
+    void emitCell(int row, int col, char c);
+    void composeFrame(EntityManager &entityManager, Entity player);
 
 public:
-    void update(EntityManager &entityManager, std::shared_ptr<Entity> player, int floor);
+    explicit DisplaySystem(GameContext &context);
+    void update(EntityManager &entityManager, Entity player, int floor);
+    // forces the next update to clear the screen and draw every cell, e.g. after other output
+    void invalidate();
+    // with the fog on, only what the player sees is drawn, and the bare map of what they remember
+    void setVision(const VisionSystem *vision);
+    // appends the byte count of each frame to the status lines
+    void setShowFrameStats(bool show);
+    std::size_t lastFrameBytes() const;
+    std::size_t totalFrameBytes() const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -8,11 +8,8 @@
 
 class InputSystem
 {
-    std::vector<std::string> valid_directions = {"no", "so", "ea", "we", "ne", "nw", "se", "sw"};
-    bool validDirection(std::string);
-
 public:
-    void update(std::string &, std::shared_ptr<Entity>);
+    void update(std::string &, Entity);
 };
 
 #endif
\ No newline at end of file
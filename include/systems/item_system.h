@@ -10,12 +10,12 @@ class Entity;
 
 class ItemSystem
 {
-    void useTreasure(EntityManager &entityManager, std::shared_ptr<Entity> player, std::shared_ptr<Entity> treasure);
-    void useCompass(EntityManager &entityManager, std::shared_ptr<Entity> player, std::shared_ptr<Entity> compass);
-    void useBarrierSuit(EntityManager &entityManager, std::shared_ptr<Entity> player, std::shared_ptr<Entity> barrierSuit);
+    void useTreasure(EntityManager &entityManager, Entity player, Entity treasure);
+    void useCompass(EntityManager &entityManager, Entity player, Entity compass);
+    void useBarrierSuit(EntityManager &entityManager, Entity player, Entity barrierSuit);
 
 public:
-    void update(EntityManager &entityManager, std::shared_ptr<Entity> player);
+    void update(EntityManager &entityManager, Entity player);
 };
 
 #endif
\ No newline at end of file
@@ -3,13 +3,50 @@
 
 
 #include "entities/entity_manager.h"
-#include <string>
+#include <cstdint>
+#include <vector>
+#include "constants/kinds.h"
+#include "map/flow_field.h"
+
+struct GameContext;
 
 class MovementSystem {
-    bool moveEntity(EntityManager& entities, Entity&, std::string& direction);
-    void moveEnemy(EntityManager& entities, Entity&);
-    void freezeEnemies(EntityManager& entities, Entity&);
+    // an enemy due to move and the cell it starts the turn in, row * width + col
+    struct EnemyTurn {
+        std::uint32_t cell;
+        EntityId enemy;
+    };
+
+    GameContext &context;
+    // reused every turn so scheduling the enemies never allocates once the buffers have grown
+    std::vector<EnemyTurn> turns;
+    std::vector<EnemyTurn> sortScratch;
+    // sorts turns by cell, which is the row-major order the enemies move in
+    void sortTurns();
+    // hostile enemies step towards the player along chaseField instead of wandering
+    bool chase = false;
+    FlowField chaseField;
+    bool chases(Entity enemy) const;
+    // with an active radius only the enemies that close to the player move, see setActiveRadius
+    int activeRadius = 0;
+    std::uint32_t currentTurn = 0; // counts every update, MoveableComponent::lastTurn refers to it
+    // fills turns with the enemies within activeRadius, in row-major order
+    void collectActive(EntityManager& entities, Entity player, bool moveableOnly);
+    void wakeActive(EntityManager& entities, Entity player);
+    // neighbour mask of the cells the entity may step onto: walkable for its kind and not occupied
+    std::uint8_t legalMoves(EntityManager& entities, Entity);
+    bool moveEntity(EntityManager& entities, Entity, Direction direction);
+    void moveEnemy(EntityManager& entities, Entity);
+    void freezeEnemies(EntityManager& entities, Entity);
     public:
-    void update(EntityManager&, std::shared_ptr<Entity>);
+    explicit MovementSystem(GameContext &context);
+    void update(EntityManager&, Entity);
+    // off by default, the original game has every enemy wander
+    void setChase(bool enabled);
+    // Enemies more than radius rows or columns away from the player sleep where they are, and
+    // the floor costs the same per turn however many of them it holds. One that wakes up catches
+    // up with the turns it slept through, a move per turn up to radius of them. 0, the default,
+    // moves every enemy every turn.
+    void setActiveRadius(int radius);
 };
 #endif // MOVEMENT_SYSTEM_H
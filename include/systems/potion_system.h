@@ -10,13 +10,16 @@
 
 class EntityManager;
 class Entity;
+struct GameContext;
 
 class PotionSystem
 {
-    void usePotion(EntityManager &entityManager, std::shared_ptr<Entity> player, std::shared_ptr<Entity> potion);
+    GameContext &context;
+    void usePotion(EntityManager &entityManager, Entity player, Entity potion);
 
 public:
-    void update(EntityManager &entityManager, std::shared_ptr<Entity> player);
+    explicit PotionSystem(GameContext &context);
+    void update(EntityManager &entityManager, Entity player);
 };
 
 #endif
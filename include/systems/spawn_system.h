@@ -9,23 +9,99 @@
 #include <utility>
 #include <fstream>
 #include <iostream>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "game/floor_cache.h"
+#include "map/placement.h"
+#include "constants/kinds.h"
+#include "entities/component_pool.h"
 
 class EntityManager;
 class Entity;
+class Rng;
+struct FloorFile;
+
+// How the stairs went. The swap is moving the player across and handing the built floor over;
+// getting that floor ready, by waiting for the worker or building it on the spot, is kept apart.
+struct TransitionStats
+{
+    int count = 0;
+    int waited = 0; // the worker was still building the floor when the stairs were taken
+    int built = 0;  // nothing was staged, the floor was built on the stairs
+    double totalMicroseconds = 0;
+    double maxMicroseconds = 0;
+    double waitMicroseconds = 0; // over the waited and built transitions
+    double maxWaitMicroseconds = 0;
+};
+
+// Floors are built when the player reaches them, from what startGame was given, and only the
+// floor being played is kept in memory. With prefetching on, the next one is built into a staging
+// manager while it is played, on a worker thread the system keeps for its lifetime, and taking
+// the stairs swaps it in.
 class SpawnSystem
 {
-    std::shared_ptr<Entity> spawnDragonAround(EntityManager &entityManager, int row, int col, bool spawnWithCompass);
-    void moveToNextFloor(std::vector<EntityManager> &entityManagers, int &floor, std::shared_ptr<Entity> &player);
+    int seed = 0;
+    Race race = Race::HUMAN;
+    std::shared_ptr<const FloorFile> floorFile; // floors are read from here when set, generated otherwise
+    int floorCount = 0;
+    int barrierSuitFloor = 0;
+    FloorCache cache;
+    Placement placement; // free room cells of the floor newFloor is generating
+
+    // Pre-built component bundles, one entity of blueprints per kind, made from the game data
+    // when the system is created. A spawn stamps a copy into the floor and only sets what
+    // differs per entity, like the position.
+    std::unique_ptr<EntityManager> blueprints;
+    EntityId raceBlueprints[std::size_t(Race::COUNT)];
+    EntityId enemyBlueprints[std::size_t(EnemyKind::COUNT)];
+    EntityId potionBlueprints[std::size_t(PotionKind::COUNT)];
+    EntityId itemBlueprints[std::size_t(ItemKind::COUNT)];
+    EntityId hoardBlueprint;
+
+    bool prefetch = false;
+    std::unique_ptr<EntityManager> staging;
+    int stagedFloor = -1;
+    TransitionStats transitions;
+
+    // the worker, started by the first prefetch; requested is the floor it should build next
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    int requested = -1;
+    bool building = false;
+    bool stopping = false;
+    std::thread worker;
+
+    void buildBlueprints();
+    void buildFloor(EntityManager &entityManager, int floor);
+    void startPrefetch(int floor);
+    void work();
+    // returns false if the worker was not done yet
+    bool waitForPrefetch();
+    void readFloor(EntityManager &entityManager, int floor);
+    Entity spawnDragonAround(EntityManager &entityManager, Rng &rng, int row, int col, bool spawnWithCompass);
+    void moveToNextFloor(EntityManager &entityManager, int &floor, Entity &player);
 
 public:
-    void readFloors(std::vector<EntityManager> &entityManagers, const std::string &filePath, const std::string &race);
-    void newFloor(EntityManager &entityManager, const int seed, bool spawn_barrier_suit, const std::string &race);
-    std::shared_ptr<Entity> spawnPlayer(EntityManager &entityManager, int x, int y, const std::string &race);
-    std::shared_ptr<Entity> spawnEnemy(EntityManager &entityManager, int x, int y, const std::string &enemyType, bool withCompass);
-    std::shared_ptr<Entity> spawnPotion(EntityManager &entityManager, int x, int y, const std::string &potionType);
-    std::shared_ptr<Entity> spawnTreasure(EntityManager &entityManager, int x, int y, const int &value);
-    std::shared_ptr<Entity> spawnItem(EntityManager &entityManager, int x, int y, const std::string &itemType);
-    void update(std::vector<EntityManager> &entityManagers, int &floor, std::shared_ptr<Entity> &player);
+    SpawnSystem();
+    ~SpawnSystem();
+
+    // forgets the floors of the previous game and builds the first one into entityManager
+    void startGame(EntityManager &entityManager, int seed, Race race, std::shared_ptr<const FloorFile> floorFile, int floorCount, int barrierSuitFloor);
+    void newFloor(EntityManager &entityManager, const int seed, bool spawn_barrier_suit, Race race);
+    Entity spawnPlayer(EntityManager &entityManager, int x, int y, Race race);
+    Entity spawnEnemy(EntityManager &entityManager, int x, int y, EnemyKind enemyType, bool withCompass);
+    Entity spawnPotion(EntityManager &entityManager, int x, int y, PotionKind potionType);
+    Entity spawnTreasure(EntityManager &entityManager, int x, int y, const int &value, bool hoard);
+    Entity spawnItem(EntityManager &entityManager, int x, int y, ItemKind itemType);
+    // replaces the floor in entityManager with the next one when the player takes the stairs
+    void update(EntityManager &entityManager, int &floor, Entity &player);
+    // With prefetching off, the default, every floor is built when the stairs are taken. It only
+    // shortens the stairs when the game pauses between floors, like a player reading the screen;
+    // games played straight through wait for the worker instead, see the stairs bench.
+    void setPrefetch(bool enabled);
+    const TransitionStats &getTransitionStats() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef VISION_SYSTEM_H
+#define VISION_SYSTEM_H
+
+#include <vector>
+#include "map/bitboard.h"
+
+class EntityManager;
+class Entity;
+
+// Fog of war: what the player sees this turn and every cell of each floor they have seen so
+// far. Off by default, the original game shows the whole floor.
+class VisionSystem
+{
+    bool enabled = false;
+    Bitboard visible;
+    // one per floor reached this game, the floors the player has left keep theirs
+    std::vector<Bitboard> explored;
+    int floor = 0;
+    int lastRow = 0; // where the view was cast from, it reaches SIGHT_RADIUS rows either way
+
+public:
+    // forgets every floor, for a new game
+    void reset();
+    // Recomputes what the player sees on floor and adds it to what they have explored there.
+    // Costs what is in sight, not the size of the map.
+    void update(EntityManager &entityManager, Entity player, int floor);
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    bool isVisible(int row, int col) const;
+    bool isExplored(int row, int col) const;
+};
+
+#endif // VISION_SYSTEM_H
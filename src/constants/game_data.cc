@@ -0,0 +1,316 @@
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include "constants/game_data.h"
+#include "game/fnv.h"
+
+namespace
+{
+    // the stock data, the same as cc3kdata.txt
+    const char DEFAULT_GAME_DATA[] = R"(# Game data for cc3k, load it with --data. Fields are separated by spaces,
+# anything after a # is a comment.
+
+# race name health attack defense gold_multiplier score_multiplier all_positive
+# the score of a won game is the gold times the score multiplier
+race human 140 20 20 1 1.5 0
+race dwarf 100 20 30 2 1 0
+race elf 140 30 10 1 1 1
+race orc 180 30 25 0.5 1 0
+
+# enemy name glyph health attack defense gold hostile
+enemy vampire V 50 25 25 1 1
+enemy werewolf W 120 30 5 1 1
+enemy troll T 120 25 15 1 1
+enemy goblin N 70 5 10 1 1
+enemy merchant M 30 70 5 0 0
+enemy dragon D 150 20 20 0 1
+enemy phoenix X 50 35 20 1 1
+
+# potion name health attack defense positive_counterpart
+potion RH 10 0 0 RH
+potion BA 0 5 0 BA
+potion BD 0 0 5 BD
+potion PH -10 0 0 RH
+potion WA 0 -5 0 BA
+potion WD 0 0 -5 BD
+
+# spawn enemy weight, random enemies of a floor are drawn with these weights
+spawn werewolf 4
+spawn vampire 3
+spawn goblin 5
+spawn troll 2
+spawn phoenix 2
+spawn merchant 2
+
+# treasure value weight hoard, a hoard is guarded by a dragon
+treasure 1 5 0
+treasure 6 1 1
+treasure 2 2 0
+)";
+
+    template <typename Kind>
+    bool kindByName(const std::string &name, const char *const *names, Kind &kind)
+    {
+        for (std::size_t i = 0; i < std::size_t(Kind::COUNT); i++)
+        {
+            if (name == names[i])
+            {
+                kind = Kind(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool flag(int value)
+    {
+        if (value != 0 && value != 1)
+        {
+            throw std::string("expected 0 or 1");
+        }
+        return value;
+    }
+
+    // An enemy glyph stands for that enemy in floor files and on screen, so it may not be
+    // anything else either place uses: layout, the digits of potions and treasure, the player,
+    // the potion glyph or an item
+    void checkEnemyGlyph(char glyph)
+    {
+        if (!std::isgraph(static_cast<unsigned char>(glyph)))
+        {
+            throw std::string("enemy glyphs have to be printable");
+        }
+        if (std::strchr("|-+#.", glyph) || std::isdigit(static_cast<unsigned char>(glyph)))
+        {
+            throw std::string("glyph ") + glyph + " is part of the floor file format";
+        }
+        if (glyph == '@' || glyph == 'P')
+        {
+            throw std::string("glyph ") + glyph + " is used by the " + (glyph == '@' ? "player" : "potions");
+        }
+        for (const ItemTraits &item : ITEM_TRAITS)
+        {
+            if (glyph == item.display)
+            {
+                throw std::string("glyph ") + glyph + " is used by the " + item.name;
+            }
+        }
+    }
+
+    GameData &activeData()
+    {
+        static GameData data = parseGameData(DEFAULT_GAME_DATA, "built-in data");
+        return data;
+    }
+}
+
+GameData parseGameData(const std::string &text, const std::string &source)
+{
+    GameData data;
+    data.hash = fnv1a(text.data(), text.size());
+    bool enemyDefined[std::size_t(EnemyKind::COUNT)] = {};
+    bool potionDefined[std::size_t(PotionKind::COUNT)] = {};
+    bool raceDefined[std::size_t(Race::COUNT)] = {};
+    const char *glyphOwner[256] = {}; // the enemy each glyph is taken by
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(lines, line))
+    {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string keyword, name;
+        if (!(fields >> keyword))
+        {
+            continue;
+        }
+
+        try
+        {
+            fields >> name;
+            if (keyword == "race")
+            {
+                Race race;
+                if (!kindByName(name, RACE_NAMES, race))
+                {
+                    throw "unknown race " + name;
+                }
+                if (raceDefined[std::size_t(race)])
+                {
+                    throw "race " + name + " is defined twice";
+                }
+                RaceTraits &traits = data.races[std::size_t(race)];
+                int allPositive = 0;
+                fields >> traits.health >> traits.attack >> traits.defense >> traits.goldMultiplier >> traits.scoreMultiplier >> allPositive;
+                if (fields && (traits.health <= 0 || traits.attack <= 0 || traits.goldMultiplier <= 0 || traits.scoreMultiplier <= 0))
+                {
+                    throw std::string("health, attack and the gold and score multipliers have to be positive");
+                }
+                if (fields && traits.defense < 0)
+                {
+                    throw std::string("defense cannot be negative");
+                }
+                traits.name = RACE_NAMES[std::size_t(race)];
+                traits.letter = RACE_LETTERS[std::size_t(race)];
+                traits.allPositive = flag(allPositive);
+                raceDefined[std::size_t(race)] = true;
+            }
+            else if (keyword == "enemy")
+            {
+                EnemyKind kind;
+                if (!kindByName(name, ENEMY_NAMES, kind))
+                {
+                    throw "unknown enemy " + name;
+                }
+                if (enemyDefined[std::size_t(kind)])
+                {
+                    throw "enemy " + name + " is defined twice";
+                }
+                EnemyTraits &traits = data.enemies[std::size_t(kind)];
+                int hostile = 0;
+                fields >> traits.display >> traits.health >> traits.attack >> traits.defense >> traits.gold >> hostile;
+                if (fields)
+                {
+                    checkEnemyGlyph(traits.display);
+                    const char *&owner = glyphOwner[static_cast<unsigned char>(traits.display)];
+                    if (owner)
+                    {
+                        throw std::string("glyph ") + traits.display + " is already used by the " + owner;
+                    }
+                    owner = ENEMY_NAMES[std::size_t(kind)];
+                }
+                if (fields && (traits.health <= 0 || traits.attack <= 0))
+                {
+                    throw std::string("health and attack have to be positive");
+                }
+                if (fields && (traits.defense < 0 || traits.gold < 0))
+                {
+                    throw std::string("defense and gold cannot be negative");
+                }
+                traits.name = ENEMY_NAMES[std::size_t(kind)];
+                traits.hostile = flag(hostile);
+                enemyDefined[std::size_t(kind)] = true;
+            }
+            else if (keyword == "potion")
+            {
+                PotionKind kind;
+                if (!kindByName(name, POTION_NAMES, kind))
+                {
+                    throw "unknown potion " + name;
+                }
+                if (potionDefined[std::size_t(kind)])
+                {
+                    throw "potion " + name + " is defined twice";
+                }
+                PotionTraits &traits = data.potions[std::size_t(kind)];
+                std::string positive;
+                fields >> traits.health >> traits.attack >> traits.defense >> positive;
+                if (fields && !kindByName(positive, POTION_NAMES, traits.positive))
+                {
+                    throw "unknown potion " + positive;
+                }
+                traits.name = POTION_NAMES[std::size_t(kind)];
+                potionDefined[std::size_t(kind)] = true;
+            }
+            else if (keyword == "spawn")
+            {
+                EnemyRoll roll;
+                if (!kindByName(name, ENEMY_NAMES, roll.kind))
+                {
+                    throw "unknown enemy " + name;
+                }
+                fields >> roll.weight;
+                if (fields && roll.weight <= 0)
+                {
+                    throw std::string("weights have to be positive");
+                }
+                data.enemySpawns.push_back(roll);
+                data.enemySpawnWeight += roll.weight;
+            }
+            else if (keyword == "treasure")
+            {
+                TreasureRoll roll;
+                int hoard = 0;
+                std::istringstream value(name);
+                value >> roll.value;
+                fields >> roll.weight >> hoard;
+                if (!value || roll.value <= 0)
+                {
+                    throw std::string("treasure values have to be positive");
+                }
+                if (fields && roll.weight <= 0)
+                {
+                    throw std::string("weights have to be positive");
+                }
+                roll.hoard = flag(hoard);
+                data.treasures.push_back(roll);
+                data.treasureWeight += roll.weight;
+            }
+            else
+            {
+                throw "unknown keyword " + keyword;
+            }
+
+            std::string extra;
+            if (!fields)
+            {
+                throw keyword + " has missing or malformed fields";
+            }
+            if (fields >> extra)
+            {
+                throw "unexpected " + extra;
+            }
+        }
+        catch (std::string e)
+        {
+            throw source + ":" + std::to_string(lineNumber) + ": " + e;
+        }
+    }
+
+    for (std::size_t i = 0; i < std::size_t(Race::COUNT); i++)
+    {
+        if (!raceDefined[i])
+        {
+            throw source + ": race " + RACE_NAMES[i] + " is missing";
+        }
+    }
+    for (std::size_t i = 0; i < std::size_t(EnemyKind::COUNT); i++)
+    {
+        if (!enemyDefined[i])
+        {
+            throw source + ": enemy " + ENEMY_NAMES[i] + " is missing";
+        }
+    }
+    for (std::size_t i = 0; i < std::size_t(PotionKind::COUNT); i++)
+    {
+        if (!potionDefined[i])
+        {
+            throw source + ": potion " + POTION_NAMES[i] + " is missing";
+        }
+    }
+    if (data.enemySpawns.empty() || data.treasures.empty())
+    {
+        throw source + ": the spawn and treasure tables need at least one entry each";
+    }
+    return data;
+}
+
+void loadGameData(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw "Cannot open game data " + path;
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    activeData() = parseGameData(text.str(), path);
+}
+
+const GameData &gameData()
+{
+    return activeData();
+}
@@ -1,38 +1,357 @@
-#include "entities/entity_manager.h"
-
-std::shared_ptr<Entity> EntityManager::createEntity()
-{
-    auto entity = std::make_shared<Entity>();
-    entities.push_back(entity);
-    return entity;
-}
-
-void EntityManager::removeEntity(std::shared_ptr<Entity> entity)
-{
-    // moves all elements equal to entity to the end of the vector and returns an iterator to the new end of the vector, then erase
-    entities.erase(std::remove(entities.begin(), entities.end(), entity), entities.end());
-}
-
-std::shared_ptr<Entity> EntityManager::getEntity(int row, int col)
-{
-    for (auto entity : entities)
-    {
-        auto position_component = entity->getComponent<PositionComponent>();
-
-        if (!position_component)
-        {
-            continue;
-        }
-
-        if (position_component->row == row && position_component->col == col)
-        {
-            return entity;
-        }
-    }
-    return nullptr;
-}
-
-std::vector<std::shared_ptr<Entity>> &EntityManager::getEntities()
-{
-    return entities;
-}
\ No newline at end of file
+#include <cassert>
+#include <cstring>
+#include "entities/entity_manager.h"
+
+const EntityId EntityManager::NO_ENTITY;
+
+// enough for the player, stairs, 10 potions, 10 treasures, 20 enemies and the odd dragon
+const std::size_t FLOOR_ENTITY_CAPACITY = 64;
+
+namespace
+{
+    template <typename T>
+    void write(std::string &out, const T &value)
+    {
+        out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    const char *read(const char *in, T &value)
+    {
+        std::memcpy(&value, in, sizeof(T));
+        return in + sizeof(T);
+    }
+
+    template <typename T>
+    void writeArray(std::string &out, const StorageVector<T> &values)
+    {
+        write(out, static_cast<std::uint32_t>(values.size()));
+        out.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+    }
+
+    template <typename T>
+    const char *readArray(const char *in, StorageVector<T> &values)
+    {
+        std::uint32_t count;
+        in = read(in, count);
+        values.resize(count);
+        if (count > 0)
+        {
+            std::memcpy(values.data(), in, count * sizeof(T));
+        }
+        return in + count * sizeof(T);
+    }
+}
+
+EntityManager::EntityManager()
+{
+    setMap(boardMap());
+    reserve(FLOOR_ENTITY_CAPACITY);
+}
+
+int EntityManager::cellIndex(int row, int col) const
+{
+    if (row < 0 || row >= height || col < 0 || col >= width)
+    {
+        return -1;
+    }
+    return row * width + col;
+}
+
+void EntityManager::link(EntityId entity, int row, int col)
+{
+    if (entity >= nextInCell.size())
+    {
+        nextInCell.resize(entity + 1, NO_ENTITY);
+    }
+    nextInCell[entity] = NO_ENTITY;
+
+    int cell = cellIndex(row, col);
+    if (cell < 0)
+    {
+        return;
+    }
+
+    // append so the oldest occupant of a cell stays the one getEntity returns
+    EntityId *slot = &cellHeads[cell];
+    while (*slot != NO_ENTITY)
+    {
+        slot = &nextInCell[*slot];
+    }
+    *slot = entity;
+    occupancy.set(row, col);
+}
+
+void EntityManager::unlink(EntityId entity, int row, int col)
+{
+    int cell = cellIndex(row, col);
+    if (cell < 0)
+    {
+        return;
+    }
+
+    EntityId *slot = &cellHeads[cell];
+    while (*slot != NO_ENTITY && *slot != entity)
+    {
+        slot = &nextInCell[*slot];
+    }
+    if (*slot == entity)
+    {
+        *slot = nextInCell[entity];
+        nextInCell[entity] = NO_ENTITY;
+    }
+    if (cellHeads[cell] == NO_ENTITY)
+    {
+        occupancy.reset(row, col);
+    }
+}
+
+template <>
+void EntityManager::addComponent<PositionComponent>(EntityId entity, PositionComponent component)
+{
+    PositionComponent *position = pool<PositionComponent>().get(entity);
+    if (position)
+    {
+        unlink(entity, position->row, position->col);
+    }
+    link(entity, component.row, component.col);
+    pool<PositionComponent>().add(entity, component);
+    signatures[entity] |= SignatureOf<PositionComponent>::value;
+}
+
+template <>
+void EntityManager::removeComponent<PositionComponent>(EntityId entity)
+{
+    PositionComponent *position = pool<PositionComponent>().get(entity);
+    if (!position)
+    {
+        return;
+    }
+    unlink(entity, position->row, position->col);
+    pool<PositionComponent>().remove(entity);
+    signatures[entity] &= ~SignatureOf<PositionComponent>::value;
+}
+
+Entity EntityManager::createEntity()
+{
+    Entity entity{this, nextId++};
+    entities.push_back(entity.id());
+    signatures.resize(nextId, 0);
+    return entity;
+}
+
+Entity EntityManager::instantiate(const EntityManager &prototypes, EntityId prototype)
+{
+    Entity entity = createEntity();
+    // positions have to go through the spatial index, the caller places the entity
+    Signature signature = prototypes.signatures[prototype] & ~SignatureOf<PositionComponent>::value;
+    copyComponents(entity.id(), prototypes, prototype, signature, std::make_index_sequence<NUM_COMPONENTS>());
+    signatures[entity.id()] = signature;
+    return entity;
+}
+
+void EntityManager::removeEntity(Entity entity)
+{
+    removeComponent<PositionComponent>(entity.id());
+    removeComponents(entity.id(), signatures[entity.id()], std::make_index_sequence<NUM_COMPONENTS>());
+    signatures[entity.id()] = 0;
+    // moves all elements equal to entity to the end of the vector and returns an iterator to the new end of the vector, then erase
+    entities.erase(std::remove(entities.begin(), entities.end(), entity.id()), entities.end());
+}
+
+Entity EntityManager::getEntity(int row, int col)
+{
+    int cell = cellIndex(row, col);
+    if (cell < 0 || cellHeads[cell] == NO_ENTITY)
+    {
+        return Entity{};
+    }
+    return Entity{this, cellHeads[cell]};
+}
+
+std::array<Entity, 8> EntityManager::getNeighbours(int row, int col)
+{
+    std::array<Entity, 8> neighbours;
+    // only look up the cells the occupancy mask says are taken
+    for (std::uint32_t mask = occupancy.neighbours(row, col); mask; mask &= mask - 1)
+    {
+        int bit = __builtin_ctz(mask);
+        neighbours[bit] = getEntity(row + DIRECTION_ROW[bit], col + DIRECTION_COL[bit]);
+    }
+    return neighbours;
+}
+
+void EntityManager::setPosition(Entity entity, int row, int col)
+{
+    addComponent(entity.id(), PositionComponent(row, col));
+}
+
+bool EntityManager::validateSpatialIndex()
+{
+    // Starts from the entities rather than the cells, so a check costs the same on the biggest
+    // map as on the smallest. Every cell list is walked from its head.
+    ComponentPool<PositionComponent> &positions = pool<PositionComponent>();
+    std::size_t linked = 0;
+    std::size_t occupied = 0;
+    std::size_t onBoard = 0;
+    for (std::size_t slot = 0; slot < positions.size(); slot++)
+    {
+        const PositionComponent &position = positions.at(slot);
+        int cell = cellIndex(position.row, position.col);
+        if (cell < 0)
+        {
+            continue;
+        }
+        onBoard++;
+        if (cellHeads[cell] != positions.owner(slot))
+        {
+            continue;
+        }
+        occupied++;
+        if (!occupancy.test(position.row, position.col))
+        {
+            assert(false && "occupancy bitboard is out of sync with the spatial index");
+            return false;
+        }
+        for (EntityId id = cellHeads[cell]; id != NO_ENTITY; id = nextInCell[id])
+        {
+            PositionComponent *other = positions.get(id);
+            if (!other || cellIndex(other->row, other->col) != cell)
+            {
+                assert(false && "spatial index is out of sync with PositionComponent");
+                return false;
+            }
+            linked++;
+        }
+    }
+
+    // a cell whose head stands somewhere else is never walked, and shows up as a set bit too many
+    if (occupancy.count() != occupied)
+    {
+        assert(false && "occupancy bitboard has a bit set for a cell no entity stands in");
+        return false;
+    }
+    assert(linked == onBoard && "entity position was written without going through the spatial index");
+    return linked == onBoard;
+}
+
+void EntityManager::reserve(std::size_t capacity)
+{
+    reservePools(capacity, std::make_index_sequence<NUM_COMPONENTS>());
+    entities.reserve(capacity);
+    signatures.reserve(capacity);
+    nextInCell.reserve(capacity);
+}
+
+void EntityManager::pageOut(FloorPage &page) const
+{
+    page.map = map;
+    page.bytes.clear();
+    write(page.bytes, nextId);
+    writeArray(page.bytes, entities);
+    writeArray(page.bytes, signatures);
+    savePools(page.bytes, std::make_index_sequence<NUM_COMPONENTS>());
+
+    // every cell list head first to last, so pageIn links them back in the same order
+    std::size_t countAt = page.bytes.size();
+    std::uint32_t count = 0;
+    write(page.bytes, count);
+    const ComponentPool<PositionComponent> &positions = std::get<ComponentId<PositionComponent>::value>(pools);
+    for (EntityId head : entities)
+    {
+        const PositionComponent *position = positions.get(head);
+        if (!position || cellIndex(position->row, position->col) < 0 || cellHeads[cellIndex(position->row, position->col)] != head)
+        {
+            continue;
+        }
+        for (EntityId id = head; id != NO_ENTITY; id = nextInCell[id])
+        {
+            write(page.bytes, id);
+            count++;
+        }
+    }
+    std::memcpy(&page.bytes[countAt], &count, sizeof(count));
+}
+
+void EntityManager::pageIn(const FloorPage &page)
+{
+    setMap(page.map);
+    const char *in = page.bytes.data();
+    in = read(in, nextId);
+    in = readArray(in, entities);
+    in = readArray(in, signatures);
+    in = loadPools(in, std::make_index_sequence<NUM_COMPONENTS>());
+
+    std::uint32_t count;
+    in = read(in, count);
+    for (std::uint32_t i = 0; i < count; i++)
+    {
+        EntityId id;
+        in = read(in, id);
+        PositionComponent *position = pool<PositionComponent>().get(id);
+        link(id, position->row, position->col);
+    }
+}
+
+void EntityManager::swap(EntityManager &other)
+{
+    using std::swap;
+    swap(pools, other.pools);
+    swap(signatures, other.signatures);
+    swap(map, other.map);
+    swap(height, other.height);
+    swap(width, other.width);
+    swap(cellHeads, other.cellHeads);
+    swap(nextInCell, other.nextInCell);
+    swap(occupancy, other.occupancy);
+    swap(nextId, other.nextId);
+    swap(entities, other.entities);
+}
+
+const Bitboard &EntityManager::getOccupancy() const
+{
+    return occupancy;
+}
+
+void EntityManager::setMap(std::shared_ptr<const FloorMap> newMap)
+{
+    clear();
+    if (newMap->getHeight() != height || newMap->getWidth() != width)
+    {
+        height = newMap->getHeight();
+        width = newMap->getWidth();
+        cellHeads.assign(height * width, NO_ENTITY);
+        occupancy = Bitboard(height, width);
+    }
+    map = std::move(newMap);
+}
+
+const FloorMap &EntityManager::getMap() const
+{
+    return *map;
+}
+
+const StorageVector<EntityId> &EntityManager::getEntities() const
+{
+    return entities;
+}
+
+void EntityManager::clear()
+{
+    // only the cells something stands in are reset, the map may have a million of them
+    ComponentPool<PositionComponent> &positions = pool<PositionComponent>();
+    for (std::size_t slot = 0; slot < positions.size(); slot++)
+    {
+        int cell = cellIndex(positions.at(slot).row, positions.at(slot).col);
+        if (cell >= 0)
+        {
+            cellHeads[cell] = NO_ENTITY;
+        }
+    }
+    clearPools(std::make_index_sequence<NUM_COMPONENTS>());
+    entities.clear();
+    signatures.clear();
+    nextInCell.clear();
+    occupancy.clear();
+    nextId = 0;
+}
@@ -0,0 +1,5 @@
+#include "entities/storage_allocator.h"
+
+std::atomic<std::size_t> StorageStats::allocationCount{0};
+std::atomic<std::size_t> StorageStats::deallocationCount{0};
+std::atomic<std::size_t> StorageStats::allocatedBytes{0};
@@ -0,0 +1,24 @@
+#include "game/floor_cache.h"
+
+void FloorCache::use(int newSeed, Race newRace, int floorCount)
+{
+    if (newSeed == seed && newRace == race && static_cast<int>(stored.size()) == floorCount)
+    {
+        return;
+    }
+    seed = newSeed;
+    race = newRace;
+    floors.resize(floorCount);
+    stored.assign(floorCount, false);
+}
+
+const FloorPage *FloorCache::find(int floor) const
+{
+    return stored.at(floor) ? &floors.at(floor) : nullptr;
+}
+
+void FloorCache::store(int floor, const EntityManager &generated)
+{
+    generated.pageOut(floors.at(floor));
+    stored.at(floor) = true;
+}
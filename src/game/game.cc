@@ -0,0 +1,176 @@
+#include "game/game.h"
+#include "game/fnv.h"
+#include "constants/constants.h"
+#include "constants/game_data.h"
+
+namespace
+{
+    template <typename T>
+    void hashValue(std::uint64_t &hash, const T &value)
+    {
+        hash = fnv1a(&value, sizeof(T), hash);
+    }
+}
+
+Game::Game(std::shared_ptr<const FloorFile> floorFile, int floorCount)
+    : combatSystem{context}, potionSystem{context}, movementSystem{context},
+      floorFile{std::move(floorFile)}, floorCount{floorCount} {}
+
+void Game::reset(Race race, int seed)
+{
+    floor = 0;
+    stats = GameStats();
+    context.reset(seed);
+    context.actionMessage.push_back("Player has spawned!");
+    visionSystem.reset();
+    // only the first floor is built now, the others when the player reaches them
+    int barrierSuitFloor = context.rng.below(floorCount);
+    spawnSystem.startGame(entityManager, seed, race, floorFile, floorCount, barrierSuitFloor);
+
+    player = Entity();
+    entityManager.forEach<PlayerRaceComponent>([this](Entity entity, PlayerRaceComponent &)
+                                                          { player = entity; });
+    visionSystem.update(entityManager, player, floor);
+    updateStats();
+}
+
+void Game::turn(std::string &input)
+{
+    // the order matters
+    inputSystem.update(input, player);
+    potionSystem.update(entityManager, player);
+    bool poisoned = player.getComponent<HealthComponent>()->currentHealth <= 0;
+    itemSystem.update(entityManager, player);
+    spawnSystem.update(entityManager, floor, player);
+    if (floor == floorCount)
+    {
+        // took the last stairs, there is no floor left to move on
+        stats.turns++;
+        updateStats();
+        return;
+    }
+    movementSystem.update(entityManager, player);
+    combatSystem.update(entityManager, player);
+    visionSystem.update(entityManager, player, floor);
+
+    stats.turns++;
+    updateStats();
+    if (stats.causeOfDeath.empty() && player.getComponent<HealthComponent>()->currentHealth <= 0)
+    {
+        stats.causeOfDeath = poisoned ? "poison" : context.lastAttacker == EnemyKind::COUNT ? "" : traitsOf(context.lastAttacker).name;
+    }
+}
+
+void Game::updateStats()
+{
+    stats.won = floor == floorCount;
+    stats.floor = stats.won ? floorCount : floor + 1;
+    stats.gold = player.getComponent<GoldComponent>()->gold;
+}
+
+bool Game::isOver() const
+{
+    return isWon() || player.getComponent<HealthComponent>()->currentHealth <= 0;
+}
+
+bool Game::isWon() const
+{
+    return floor == floorCount;
+}
+
+Entity Game::getPlayer() const
+{
+    return player;
+}
+
+int Game::getFloor() const
+{
+    return floor;
+}
+
+int Game::getFloorCount() const
+{
+    return floorCount;
+}
+
+EntityManager &Game::currentFloor()
+{
+    return entityManager;
+}
+
+GameContext &Game::getContext()
+{
+    return context;
+}
+
+const GameStats &Game::getStats() const
+{
+    return stats;
+}
+
+void Game::setPrefetch(bool enabled)
+{
+    spawnSystem.setPrefetch(enabled);
+}
+
+void Game::setChase(bool enabled)
+{
+    movementSystem.setChase(enabled);
+}
+
+void Game::setActiveRadius(int radius)
+{
+    movementSystem.setActiveRadius(radius);
+}
+
+void Game::setFog(bool enabled)
+{
+    visionSystem.setEnabled(enabled);
+}
+
+const VisionSystem &Game::getVision() const
+{
+    return visionSystem;
+}
+
+const TransitionStats &Game::getTransitionStats() const
+{
+    return spawnSystem.getTransitionStats();
+}
+
+std::uint64_t Game::stateHash()
+{
+    std::uint64_t hash = FNV_OFFSET;
+    hashValue(hash, floor);
+    hashValue(hash, stats.turns);
+
+    // after a win the player is still on the last floor
+    for (EntityId id : entityManager.getEntities())
+    {
+        Entity entity{&entityManager, id};
+        hashValue(hash, entity.id());
+        if (PositionComponent *position = entity.getComponent<PositionComponent>())
+        {
+            hashValue(hash, position->row);
+            hashValue(hash, position->col);
+        }
+        if (DisplayComponent *display = entity.getComponent<DisplayComponent>())
+        {
+            hashValue(hash, display->display_char);
+        }
+        if (HealthComponent *health = entity.getComponent<HealthComponent>())
+        {
+            hashValue(hash, health->currentHealth);
+        }
+        if (GoldComponent *gold = entity.getComponent<GoldComponent>())
+        {
+            hashValue(hash, gold->gold);
+        }
+        if (PotionEffectComponent *effect = entity.getComponent<PotionEffectComponent>())
+        {
+            hashValue(hash, effect->attackChange);
+            hashValue(hash, effect->defenseChange);
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,12 @@
+#include "game/game_context.h"
+
+void GameContext::reset(std::uint64_t seed)
+{
+    actionMessage.clear();
+    seenPotions = 0;
+    merchantHostile = false;
+    lastAttacker = EnemyKind::COUNT;
+    rng.seed(seed, GAME_STREAM);
+    movementRng.seed(seed, MOVEMENT_STREAM);
+    combatRng.seed(seed, COMBAT_STREAM);
+}
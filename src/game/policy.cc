@@ -0,0 +1,70 @@
+#include <vector>
+#include "game/policy.h"
+#include "game/game.h"
+#include "game/game_context.h"
+#include "constants/constants.h"
+
+RandomPolicy::RandomPolicy(unsigned seed) : rng{seed, POLICY_STREAM} {}
+
+std::string RandomPolicy::nextCommand(Game &game)
+{
+    EntityManager &entityManager = game.currentFloor();
+    PositionComponent *position = game.getPlayer().getComponent<PositionComponent>();
+
+    std::vector<std::string> attacks, pickups, potions, moves;
+    for (std::size_t direction = 0; direction < std::size_t(Direction::COUNT); direction++)
+    {
+        int row = position->row + DIRECTION_ROW[direction];
+        int col = position->col + DIRECTION_COL[direction];
+        const std::string name = DIRECTION_NAMES[direction];
+        Entity entity = entityManager.getEntity(row, col);
+        if (!entity)
+        {
+            if (entityManager.getMap().playerWalkable().test(row, col))
+            {
+                moves.push_back(name);
+            }
+        }
+        else if (entity.hasComponent<StairsComponent>())
+        {
+            return name;
+        }
+        else if (entity.hasComponent<EnemyTypeComponent>())
+        {
+            // leave peaceful merchants alone
+            if (entity.getComponent<EnemyTypeComponent>()->enemy_type != EnemyKind::MERCHANT)
+            {
+                attacks.push_back("a " + name);
+            }
+        }
+        else if (entity.hasComponent<PotionTypeComponent>())
+        {
+            potions.push_back("u " + name);
+        }
+        else if (entity.hasComponent<ItemTypeComponent>() && entity.hasComponent<CanPickupComponent>())
+        {
+            pickups.push_back(name);
+        }
+    }
+
+    for (auto choices : {&attacks, &pickups, &potions, &moves})
+    {
+        if (!choices->empty())
+        {
+            return (*choices)[rng.below(choices->size())];
+        }
+    }
+    // boxed in; the command is rejected and the policy is asked again
+    return "no";
+}
+
+ScriptPolicy::ScriptPolicy(const std::vector<std::string> &commands) : commands{commands} {}
+
+std::string ScriptPolicy::nextCommand(Game &)
+{
+    if (next == commands.size())
+    {
+        return "";
+    }
+    return commands[next++];
+}
@@ -0,0 +1,218 @@
+#include <algorithm>
+#include <chrono>
+#include "game/replay.h"
+#include "game/game.h"
+#include "constants/game_data.h"
+#include "map/floor_file.h"
+
+namespace
+{
+    const char MAGIC[] = {'C', 'C', '3', 'K'};
+    // bumped whenever the same log would play out differently:
+    //   2: enemies pick among their legal moves with a single draw
+    //   3: generated floors place spawns from per-room free-cell lists
+    //   4: the header holds the floor count, chase, active radius and input hashes
+    const char VERSION = 4;
+
+    const int NEW_GAME = 0x20;
+    const int TEXT_COMMAND = 0x21;
+    const int END = 0x22;
+
+    const char *const ACTIONS[] = {"", "a ", "u "};
+    // the order is part of the log format, not Direction's
+    const char *const DIRECTIONS[] = {"no", "so", "ea", "we", "ne", "nw", "se", "sw"};
+
+    Race raceOf(int letter)
+    {
+        try
+        {
+            return raceFromLetter(char(letter));
+        }
+        catch (std::string e)
+        {
+            throw std::string("Replay log has an unknown race");
+        }
+    }
+
+    template <typename T>
+    void writeLittleEndian(std::ofstream &out, T value)
+    {
+        for (std::size_t i = 0; i < sizeof(T); i++)
+        {
+            out.put(char((value >> (8 * i)) & 0xff));
+        }
+    }
+
+    template <typename T>
+    T readLittleEndian(std::ifstream &in)
+    {
+        T value = 0;
+        for (std::size_t i = 0; i < sizeof(T); i++)
+        {
+            int byte = in.get();
+            if (byte == EOF)
+            {
+                throw std::string("Replay log is truncated");
+            }
+            value |= T(byte) << (8 * i);
+        }
+        return value;
+    }
+}
+
+Recorder::Recorder(const std::string &path, const SessionSettings &settings) : out(path, std::ios::binary)
+{
+    if (!out)
+    {
+        throw "Cannot write replay log " + path;
+    }
+    out.write(MAGIC, sizeof(MAGIC));
+    out.put(VERSION);
+    writeLittleEndian<std::uint32_t>(out, settings.seed);
+    writeLittleEndian<std::uint32_t>(out, settings.floors);
+    writeLittleEndian<std::uint8_t>(out, settings.chase);
+    writeLittleEndian<std::uint32_t>(out, settings.activeRadius);
+    writeLittleEndian(out, settings.dataHash);
+    writeLittleEndian(out, settings.floorFileHash);
+}
+
+void Recorder::newGame(Race race)
+{
+    out.put(char(NEW_GAME));
+    out.put(RACE_LETTERS[std::size_t(race)]);
+}
+
+void Recorder::command(const std::string &input)
+{
+    for (int action = 0; action < 3; action++)
+    {
+        for (int direction = 0; direction < 8; direction++)
+        {
+            if (input == std::string(ACTIONS[action]) + DIRECTIONS[direction])
+            {
+                out.put(char(action * 8 + direction));
+                return;
+            }
+        }
+    }
+
+    // anything else is kept verbatim so it is rejected again on replay
+    std::string text = input.substr(0, 255);
+    out.put(char(TEXT_COMMAND));
+    out.put(char(text.size()));
+    out.write(text.data(), text.size());
+}
+
+void Recorder::finish(std::uint64_t stateHash)
+{
+    out.put(char(END));
+    writeLittleEndian(out, stateHash);
+    out.flush();
+}
+
+ReplayResult replay(const std::string &path, std::shared_ptr<const FloorFile> floorFile)
+{
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC))
+    {
+        throw "Not a replay log: " + path;
+    }
+    if (in.get() != VERSION)
+    {
+        throw "Unsupported replay log version: " + path;
+    }
+    SessionSettings settings;
+    settings.seed = readLittleEndian<std::uint32_t>(in);
+    settings.floors = readLittleEndian<std::uint32_t>(in);
+    settings.chase = readLittleEndian<std::uint8_t>(in);
+    settings.activeRadius = readLittleEndian<std::uint32_t>(in);
+    settings.dataHash = readLittleEndian<std::uint64_t>(in);
+    settings.floorFileHash = readLittleEndian<std::uint64_t>(in);
+    if (settings.floors < 1 || settings.activeRadius < 0)
+    {
+        throw std::string("Replay log has a malformed header");
+    }
+    if (settings.dataHash != gameData().hash)
+    {
+        throw "Replay log was recorded with other game data, load the same with --data: " + path;
+    }
+    if (settings.floorFileHash != (floorFile ? floorFile->hash : 0))
+    {
+        throw std::string(settings.floorFileHash ? "Replay log was recorded on a floor file, load the same with --file: "
+                                                 : "Replay log was recorded on generated floors, drop --file: ") +
+              path;
+    }
+    if (floorFile && floorFile->count() < settings.floors)
+    {
+        throw std::string("Replay log has more floors than its floor file");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Game game(floorFile, settings.floors);
+    game.setChase(settings.chase);
+    game.setActiveRadius(settings.activeRadius);
+    ReplayResult result;
+    while (true)
+    {
+        int tag = in.get();
+        if (tag == EOF)
+        {
+            throw std::string("Replay log ends without its final state");
+        }
+        if (tag == END)
+        {
+            result.recordedHash = readLittleEndian<std::uint64_t>(in);
+            break;
+        }
+        if (tag == NEW_GAME)
+        {
+            game.reset(raceOf(readLittleEndian<std::uint8_t>(in)), settings.seed);
+            result.games++;
+            continue;
+        }
+
+        std::string input;
+        if (tag < 3 * 8)
+        {
+            input = std::string(ACTIONS[tag / 8]) + DIRECTIONS[tag % 8];
+        }
+        else if (tag == TEXT_COMMAND)
+        {
+            input.resize(readLittleEndian<std::uint8_t>(in));
+            if (!in.read(&input[0], input.size()))
+            {
+                throw std::string("Replay log is truncated");
+            }
+        }
+        else
+        {
+            throw std::string("Replay log has an unknown record");
+        }
+        if (result.games == 0)
+        {
+            throw std::string("Replay log has a command before the first game");
+        }
+
+        // same handling as the interactive loop, minus the output
+        try
+        {
+            game.turn(input);
+        }
+        catch (std::string e)
+        {
+        }
+        catch (char const *e)
+        {
+        }
+        catch (std::exception &e)
+        {
+        }
+        game.getContext().actionMessage.clear();
+        result.commands++;
+    }
+
+    result.replayedHash = game.stateHash();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
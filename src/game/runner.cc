@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include "game/runner.h"
+#include "game/game.h"
+#include "game/policy.h"
+#include "game/work_stealing_pool.h"
+
+// a game that has not ended after this many commands is given up on
+const int COMMAND_LIMIT = 5000;
+
+std::vector<std::string> readScript(const std::string &path)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        throw "Cannot open script " + path;
+    }
+
+    std::vector<std::string> commands;
+    std::string line;
+    while (std::getline(file, line) && line != "q")
+    {
+        if (!line.empty())
+        {
+            commands.push_back(line);
+        }
+    }
+    return commands;
+}
+
+void playGame(Game &game, Policy &policy, Race race, int seed)
+{
+    game.reset(race, seed);
+    for (int commands = 0; !game.isOver() && commands < COMMAND_LIMIT; commands++)
+    {
+        std::string input = policy.nextCommand(game);
+        if (input.empty())
+        {
+            break;
+        }
+        try
+        {
+            game.turn(input);
+        }
+        // a rejected command costs nothing, the policy just picks again
+        catch (std::string e)
+        {
+        }
+        catch (char const *e)
+        {
+        }
+        catch (std::exception &e)
+        {
+        }
+        game.getContext().actionMessage.clear();
+    }
+}
+
+void runGames(const RunnerOptions &options)
+{
+    WorkStealingPool pool(options.threads);
+    std::vector<std::unique_ptr<Game>> workerGames;
+    for (unsigned worker = 0; worker < pool.size(); worker++)
+    {
+        workerGames.emplace_back(new Game(options.floorFile, options.floors));
+        workerGames.back()->setPrefetch(options.prefetch);
+        workerGames.back()->setChase(options.chase);
+        workerGames.back()->setFog(options.fog);
+        workerGames.back()->setActiveRadius(options.activeRadius);
+    }
+
+    std::vector<GameStats> results(options.games);
+    for (int i = 0; i < options.games; i++)
+    {
+        pool.submit([&options, &workerGames, &results, i](unsigned worker)
+                    {
+                        int seed = options.seed + i;
+                        Game &game = *workerGames[worker];
+                        if (options.script.empty())
+                        {
+                            RandomPolicy policy(seed);
+                            playGame(game, policy, options.race, seed);
+                        }
+                        else
+                        {
+                            ScriptPolicy policy(options.script);
+                            playGame(game, policy, options.race, seed);
+                        }
+                        results[i] = game.getStats();
+                    });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    pool.run();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    int wins = 0;
+    long totalTurns = 0, totalFloors = 0;
+    for (int i = 0; i < options.games; i++)
+    {
+        const GameStats &stats = results[i];
+        std::string result = stats.won ? "won" : !stats.causeOfDeath.empty() ? "killed by " + stats.causeOfDeath
+                                             : options.script.empty()         ? "command limit"
+                                                                              : "script ended";
+        std::cout << "game " << i << " seed " << options.seed + i << " floor " << stats.floor << " gold " << stats.gold
+                  << " turns " << stats.turns << " result " << result << '\n';
+
+        wins += stats.won;
+        totalTurns += stats.turns;
+        totalFloors += stats.floor;
+    }
+
+    int games = options.games;
+    std::cout << "games " << games << " won " << wins
+              << " mean floor " << (games ? double(totalFloors) / games : 0)
+              << " mean turns " << (games ? double(totalTurns) / games : 0)
+              << " threads " << pool.size()
+              << " seconds " << seconds
+              << " games/s " << (seconds > 0 ? games / seconds : 0) << std::endl;
+
+    TransitionStats transitions;
+    for (const std::unique_ptr<Game> &game : workerGames)
+    {
+        const TransitionStats &worker = game->getTransitionStats();
+        transitions.count += worker.count;
+        transitions.waited += worker.waited;
+        transitions.built += worker.built;
+        transitions.totalMicroseconds += worker.totalMicroseconds;
+        transitions.maxMicroseconds = std::max(transitions.maxMicroseconds, worker.maxMicroseconds);
+        transitions.waitMicroseconds += worker.waitMicroseconds;
+        transitions.maxWaitMicroseconds = std::max(transitions.maxWaitMicroseconds, worker.maxWaitMicroseconds);
+    }
+    int slow = transitions.waited + transitions.built;
+    std::cout << "stairs " << transitions.count
+              << " swap mean " << (transitions.count ? transitions.totalMicroseconds / transitions.count : 0) << "us"
+              << " max " << transitions.maxMicroseconds << "us"
+              << ", waited for the worker " << transitions.waited
+              << " built on the stairs " << transitions.built
+              << " mean " << (slow ? transitions.waitMicroseconds / slow : 0) << "us"
+              << " max " << transitions.maxWaitMicroseconds << "us" << std::endl;
+}
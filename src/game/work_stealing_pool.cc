@@ -0,0 +1,72 @@
+#include <algorithm>
+#include <thread>
+#include "game/work_stealing_pool.h"
+
+WorkStealingPool::WorkStealingPool(unsigned workers)
+{
+    for (unsigned i = 0; i < std::max(workers, 1u); i++)
+    {
+        queues.emplace_back(new Queue());
+    }
+}
+
+unsigned WorkStealingPool::size() const
+{
+    return queues.size();
+}
+
+void WorkStealingPool::submit(Task task)
+{
+    queues[nextQueue]->tasks.push_back(std::move(task));
+    nextQueue = (nextQueue + 1) % queues.size();
+}
+
+bool WorkStealingPool::take(unsigned worker, Task &task)
+{
+    for (unsigned i = 0; i < queues.size(); i++)
+    {
+        Queue &queue = *queues[(worker + i) % queues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+        {
+            continue;
+        }
+        // own work from the front, stolen work from the back
+        if (i == 0)
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        else
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        return true;
+    }
+    // nothing is submitted while running, so empty queues mean the batch is done
+    return false;
+}
+
+void WorkStealingPool::work(unsigned worker)
+{
+    Task task;
+    while (take(worker, task))
+    {
+        task(worker);
+    }
+}
+
+void WorkStealingPool::run()
+{
+    std::vector<std::thread> threads;
+    for (unsigned worker = 1; worker < queues.size(); worker++)
+    {
+        threads.emplace_back(&WorkStealingPool::work, this, worker);
+    }
+    work(0);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
@@ -1,4 +0,0 @@
-#include "globals/global.h"
-
-std::vector<std::string> actionMessage = {"Player has spawned!"};
-std::vector<std::string> seenPotions;
\ No newline at end of file
@@ -2,81 +2,49 @@
 #include <memory>
 #include <fstream>
 #include <string>
-#include "entities/entity_manager.h"
-#include "systems/combat_system.h"
-#include "systems/spawn_system.h"
+#include "game/game.h"
+#include "game/runner.h"
+#include "game/replay.h"
 #include "systems/display_system.h"
-#include "systems/input_system.h"
-#include "systems/movement_system.h"
-#include "systems/potion_system.h"
-#include "systems/item_system.h"
 #include "constants/constants.h"
-#include "globals/global.h"
+#include "constants/game_data.h"
+#include "map/floor_file.h"
 
-void reset(std::vector<EntityManager> &entityManagers, SpawnSystem &spawnSystem, int &seed, std::string &filePath, int &floor)
+Race promptRace()
 {
-    floor = 0;
-    seenPotions.clear();
-    actionMessage.clear();
-    actionMessage.push_back("Player has spawned!");
-    for (int i = 0; i < NUM_FLOORS; i++)
-    {
-        EntityManager &entityManager = entityManagers.at(i);
-        entityManager.getEntities().clear();
-    }
-
     std::cout << "What race would you like to play as? (h | e | d | o)" << std::endl;
     char race_char;
     std::cin >> race_char;
 
-    while (race_char != 'h' && race_char != 'e' && race_char != 'd' && race_char != 'o')
-    {
-        std::cout << "Invalid race. Try again." << std::endl;
-        std::cin >> race_char;
-    }
-
-    std::string race;
-    if (race_char == 'h')
-        race = "human";
-    else if (race_char == 'e')
-        race = "elf";
-    else if (race_char == 'd')
-        race = "dwarf";
-    else if (race_char == 'o')
-        race = "orc";
-
-    if (!filePath.empty())
-    {
-        spawnSystem.readFloors(entityManagers, filePath, race);
-    }
-    else
+    while (true)
     {
-        int barrier_suit_floor = std::rand() % 5;
-        for (int i = 0; i < NUM_FLOORS; i++)
+        try
         {
-            EntityManager &entityManager = entityManagers.at(i);
-            spawnSystem.newFloor(entityManager, seed * (i + 1), i == barrier_suit_floor, race);
+            return raceFromLetter(race_char);
         }
-    }
-}
-
-std::shared_ptr<Entity> getPlayer(EntityManager &entityManager)
-{
-    for (auto &entity : entityManager.getEntities())
-    {
-        if (entity->getComponent<PlayerRaceComponent>())
+        catch (std::string e)
         {
-            return entity;
+            std::cout << "Invalid race. Try again." << std::endl;
+            std::cin >> race_char;
         }
     }
-    return nullptr;
 }
 
 int main(int argc, char *argv[])
 {
     bool gameLoop = true;
+    bool frameStats = false;
+    RunnerOptions runner;
+    std::string scriptPath;
+    std::string recordPath;
+    std::string replayPath;
+    std::string raceName = "human";
+    std::string dataPath;
     std::string filePath;
     int seed = 69420;
+    // building the next floor in the background only pays while someone is reading the screen,
+    // so it is on for interactive play and off for headless games unless a flag says otherwise
+    int prefetch = -1;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -88,32 +56,207 @@ int main(int argc, char *argv[])
         {
             seed = std::atoi(argv[i + 1]);
         }
+        else if (std::string(argv[i]) == "--frame-stats")
+        {
+            frameStats = true;
+        }
+        else if (std::string(argv[i]) == "--headless" && i + 1 < argc)
+        {
+            runner.games = std::atoi(argv[i + 1]);
+        }
+        else if (std::string(argv[i]) == "--threads" && i + 1 < argc)
+        {
+            runner.threads = std::atoi(argv[i + 1]);
+        }
+        else if (std::string(argv[i]) == "--script" && i + 1 < argc)
+        {
+            scriptPath = argv[i + 1];
+        }
+        else if (std::string(argv[i]) == "--race" && i + 1 < argc)
+        {
+            raceName = argv[i + 1];
+        }
+        else if (std::string(argv[i]) == "--data" && i + 1 < argc)
+        {
+            dataPath = argv[i + 1];
+        }
+        else if (std::string(argv[i]) == "--floors" && i + 1 < argc)
+        {
+            runner.floors = std::atoi(argv[i + 1]);
+        }
+        else if (std::string(argv[i]) == "--prefetch")
+        {
+            prefetch = 1;
+        }
+        else if (std::string(argv[i]) == "--no-prefetch")
+        {
+            prefetch = 0;
+        }
+        else if (std::string(argv[i]) == "--chase")
+        {
+            runner.chase = true;
+        }
+        else if (std::string(argv[i]) == "--active-radius" && i + 1 < argc)
+        {
+            runner.activeRadius = std::atoi(argv[i + 1]);
+        }
+        else if (std::string(argv[i]) == "--fog")
+        {
+            runner.fog = true;
+        }
+        else if (std::string(argv[i]) == "--record" && i + 1 < argc)
+        {
+            recordPath = argv[i + 1];
+        }
+        else if (std::string(argv[i]) == "--replay" && i + 1 < argc)
+        {
+            replayPath = argv[i + 1];
+        }
     }
-    std::srand(seed);
 
-    SpawnSystem spawnSystem;
-    CombatSystem combatSystem;
-    DisplaySystem displaySystem;
-    PotionSystem potionSystem;
-    ItemSystem itemSystem;
-    InputSystem inputSystem;
-    MovementSystem movementSystem;
+    // before any game is set up, every game reads the same data
+    if (!dataPath.empty())
+    {
+        try
+        {
+            loadGameData(dataPath);
+        }
+        catch (std::string e)
+        {
+            std::cout << e << '\n';
+            return 1;
+        }
+    }
+
+    // parsed and checked once, every game shares the floors
+    std::shared_ptr<const FloorFile> floorFile;
+    try
+    {
+        if (runner.floors < 1)
+        {
+            throw std::string("A game needs at least one floor");
+        }
+        if (runner.activeRadius < 0)
+        {
+            throw std::string("The active radius cannot be negative");
+        }
+        if (runner.threads < 1)
+        {
+            throw std::string("Headless games need at least one thread");
+        }
+        if (!filePath.empty())
+        {
+            floorFile = std::make_shared<const FloorFile>(loadFloorFile(filePath));
+            // a replay plays as many floors as its log says
+            if (floorFile->count() < runner.floors && replayPath.empty())
+            {
+                throw filePath + ": holds " + std::to_string(floorFile->count()) + " floors, a game needs " + std::to_string(runner.floors);
+            }
+        }
+    }
+    catch (std::string e)
+    {
+        std::cout << e << '\n';
+        return 1;
+    }
+
+    if (!replayPath.empty())
+    {
+        try
+        {
+            ReplayResult result = replay(replayPath, floorFile);
+            std::cout << "Replayed " << result.games << " games, " << result.commands << " commands in "
+                      << result.seconds << "s: state hash " << std::hex << result.replayedHash;
+            if (result.matches())
+            {
+                std::cout << " matches the recording" << std::endl;
+                return 0;
+            }
+            std::cout << " but the recording ended in " << result.recordedHash << std::endl;
+        }
+        catch (std::string e)
+        {
+            std::cout << e << '\n';
+        }
+        return 1;
+    }
+
+    if (runner.games > 0)
+    {
+        runner.seed = seed;
+        runner.prefetch = prefetch == 1;
+        runner.floorFile = floorFile;
+        try
+        {
+            runner.race = raceFromName(raceName);
+            if (!scriptPath.empty())
+            {
+                runner.script = readScript(scriptPath);
+            }
+        }
+        catch (std::string e)
+        {
+            std::cout << e << '\n';
+            return 1;
+        }
+        runGames(runner);
+        return 0;
+    }
 
     // Setup
-    int floor = 0;
-    std::vector<EntityManager> entityManagers(NUM_FLOORS);
-    reset(entityManagers, spawnSystem, seed, filePath, floor);
+    Game game(floorFile, runner.floors);
+    game.setPrefetch(prefetch != 0);
+    game.setChase(runner.chase);
+    game.setFog(runner.fog);
+    game.setActiveRadius(runner.activeRadius);
+    DisplaySystem displaySystem(game.getContext());
+    displaySystem.setVision(&game.getVision());
+    displaySystem.setShowFrameStats(frameStats);
 
-    // Game
-    shared_ptr<Entity> player = getPlayer(entityManagers[floor]);
+    std::unique_ptr<Recorder> recorder;
+    if (!recordPath.empty())
+    {
+        try
+        {
+            SessionSettings settings;
+            settings.seed = seed;
+            settings.floors = runner.floors;
+            settings.chase = runner.chase;
+            settings.activeRadius = runner.activeRadius;
+            settings.dataHash = gameData().hash;
+            settings.floorFileHash = floorFile ? floorFile->hash : 0;
+            recorder.reset(new Recorder(recordPath, settings));
+        }
+        catch (std::string e)
+        {
+            std::cout << e << '\n';
+            return 1;
+        }
+    }
 
-    displaySystem.update(entityManagers[floor], player, floor);
-    actionMessage.clear();
+    auto newGame = [&]()
+    {
+        Race race = promptRace();
+        if (recorder)
+        {
+            recorder->newGame(race);
+        }
+        game.reset(race, seed);
+        displaySystem.invalidate();
+        displaySystem.update(game.currentFloor(), game.getPlayer(), game.getFloor());
+    };
+
+    // Game
+    newGame();
+    game.getContext().actionMessage.clear();
 
     while (gameLoop)
     {
         string input, command;
-        std::getline(cin, input);
+        if (!std::getline(cin, input))
+        {
+            break;
+        }
         if (input.empty())
         {
             continue;
@@ -121,9 +264,7 @@ int main(int argc, char *argv[])
 
         if (input == "r")
         {
-            reset(entityManagers, spawnSystem, seed, filePath, floor);
-            player = getPlayer(entityManagers[floor]);
-            displaySystem.update(entityManagers[floor], player, floor);
+            newGame();
             continue;
         }
         else if (input == "q")
@@ -132,16 +273,18 @@ int main(int argc, char *argv[])
             break;
         }
 
+        if (recorder)
+        {
+            recorder->command(input);
+        }
+
         try
         {
-            // the order matters
-            inputSystem.update(input, player);
-            potionSystem.update(entityManagers[floor], player);
-            itemSystem.update(entityManagers[floor], player);
-            spawnSystem.update(entityManagers, floor, player);
-            movementSystem.update(entityManagers[floor], player);
-            combatSystem.update(entityManagers[floor], player);
-            displaySystem.update(entityManagers[floor], player, floor);
+            game.turn(input);
+            if (!game.isWon())
+            {
+                displaySystem.update(game.currentFloor(), game.getPlayer(), game.getFloor());
+            }
         }
         catch (std::string e)
         {
@@ -155,10 +298,12 @@ int main(int argc, char *argv[])
         {
             std::cout << "Exception: " << e.what() << '\n';
         }
-        actionMessage.clear();
+        game.getContext().actionMessage.clear();
+
+        Entity player = game.getPlayer();
 
         // Lost the game
-        if (player->getComponent<HealthComponent>()->currentHealth <= 0)
+        if (player.getComponent<HealthComponent>()->currentHealth <= 0)
         {
             std::cout << "You died!" << std::endl;
             std::cout << "Would you like to play again? (y/n)" << std::endl;
@@ -166,9 +311,7 @@ int main(int argc, char *argv[])
             std::cin >> playAgain;
             if (playAgain == 'y')
             {
-                reset(entityManagers, spawnSystem, seed, filePath, floor);
-                player = getPlayer(entityManagers[floor]);
-                displaySystem.update(entityManagers[floor], player, floor);
+                newGame();
             }
             else
             {
@@ -177,15 +320,11 @@ int main(int argc, char *argv[])
         }
 
         // Won the game
-        if (floor == NUM_FLOORS)
+        if (game.isWon())
         {
             std::cout << "Congratulations! You have completed the game!" << std::endl;
 
-            float score = player->getComponent<GoldComponent>()->gold;
-            if (player->getComponent<PlayerRaceComponent>()->race == "human")
-            {
-                score *= 1.5;
-            }
+            float score = player.getComponent<GoldComponent>()->gold * traitsOf(player.getComponent<PlayerRaceComponent>()->race).scoreMultiplier;
 
             std::ostringstream scoreStream;
             scoreStream << std::fixed << std::setprecision(1) << score;
@@ -197,9 +336,7 @@ int main(int argc, char *argv[])
             std::cin >> playAgain;
             if (playAgain == 'y')
             {
-                reset(entityManagers, spawnSystem, seed, filePath, floor);
-                player = getPlayer(entityManagers[floor]);
-                displaySystem.update(entityManagers[floor], player, floor);
+                newGame();
             }
             else
             {
@@ -208,5 +345,9 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (recorder)
+    {
+        recorder->finish(game.stateHash());
+    }
     return 0;
 }
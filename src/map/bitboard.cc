@@ -0,0 +1,24 @@
+#include <algorithm>
+#include "map/bitboard.h"
+
+Bitboard::Bitboard(int rows, int cols) : rows{rows}, cols{cols}, stride{(cols + 63) / 64}, words(rows * stride, 0) {}
+
+void Bitboard::clear()
+{
+    std::fill(words.begin(), words.end(), 0);
+    population = 0;
+}
+
+void Bitboard::clearRows(int first, int last)
+{
+    first = std::max(first, 0);
+    last = std::min(last, rows - 1);
+    for (int row = first; row <= last; row++)
+    {
+        for (int word = row * stride; word < (row + 1) * stride; word++)
+        {
+            population -= __builtin_popcountll(words[word]);
+            words[word] = 0;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+#include "map/field_of_view.h"
+
+namespace
+{
+    // maps the octant's (depth, offset) onto the map: row += depth * rowDepth + offset * rowOffset,
+    // and the same for columns
+    struct Octant
+    {
+        int rowDepth, rowOffset, colDepth, colOffset;
+    };
+
+    const Octant OCTANTS[8] = {
+        {-1, 0, 0, -1}, {-1, 0, 0, 1}, {1, 0, 0, -1}, {1, 0, 0, 1},
+        {0, -1, -1, 0}, {0, 1, -1, 0}, {0, -1, 1, 0}, {0, 1, 1, 0},
+    };
+
+    struct Caster
+    {
+        const Bitboard &transparent;
+        Bitboard &visible;
+        Bitboard &seen;
+        int row, col, radius;
+
+        // Scans rows depth and beyond of the octant between the slopes start and end, start the
+        // steeper one. A slope is offset / depth measured to the centre of the origin.
+        void scan(const Octant &octant, int depth, double start, double end)
+        {
+            if (start < end)
+            {
+                return;
+            }
+            const int radiusSquared = radius * radius;
+            for (; depth <= radius; depth++)
+            {
+                bool blocked = false;
+                double nextStart = start;
+                for (int offset = depth; offset >= 0; offset--)
+                {
+                    // The cell spans the slopes (offset - 0.5) / (depth + 0.5) up to
+                    // (offset + 0.5) / (depth - 0.5). They are compared multiplied out, and only
+                    // divided where a wall needs them.
+                    if (offset - 0.5 > start * (depth + 0.5))
+                    {
+                        continue;
+                    }
+                    if (offset + 0.5 < end * (depth - 0.5))
+                    {
+                        break;
+                    }
+
+                    int cellRow = row + depth * octant.rowDepth + offset * octant.rowOffset;
+                    int cellCol = col + depth * octant.colDepth + offset * octant.colOffset;
+                    if (depth * depth + offset * offset <= radiusSquared)
+                    {
+                        visible.set(cellRow, cellCol);
+                        seen.set(cellRow, cellCol);
+                    }
+
+                    bool opaque = !transparent.test(cellRow, cellCol);
+                    if (blocked)
+                    {
+                        if (opaque)
+                        {
+                            nextStart = (offset - 0.5) / (depth + 0.5);
+                            continue;
+                        }
+                        blocked = false;
+                        start = nextStart;
+                    }
+                    else if (opaque && depth < radius)
+                    {
+                        // what lies behind this run of walls is scanned separately, above it
+                        blocked = true;
+                        scan(octant, depth + 1, start, (offset + 0.5) / (depth - 0.5));
+                        nextStart = (offset - 0.5) / (depth + 0.5);
+                    }
+                }
+                if (blocked)
+                {
+                    return;
+                }
+            }
+        }
+    };
+}
+
+void castFieldOfView(const Bitboard &transparent, int row, int col, int radius, Bitboard &visible, Bitboard &seen)
+{
+    visible.set(row, col);
+    seen.set(row, col);
+    Caster caster{transparent, visible, seen, row, col, radius};
+    for (const Octant &octant : OCTANTS)
+    {
+        caster.scan(octant, 1, 1.0, 0.0);
+    }
+}
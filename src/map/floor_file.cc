@@ -0,0 +1,404 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "map/floor_file.h"
+#include "map/bitboard.h"
+#include "constants/constants.h"
+#include "constants/game_data.h"
+#include "game/fnv.h"
+
+namespace
+{
+    struct TileAction
+    {
+        bool layout; // part of the map itself
+        bool spawns;
+        FloorSpawn::Kind kind;
+        std::uint8_t type;
+    };
+
+    using TileTable = std::array<TileAction, 256>;
+
+    // what every byte is, one lookup per tile instead of a chain of comparisons
+    TileTable tileTable()
+    {
+        TileTable table{};
+        for (char tile : {'|', '-', '+', '#', '.', ' '})
+        {
+            table[static_cast<unsigned char>(tile)].layout = true;
+        }
+        auto set = [&table](char glyph, FloorSpawn::Kind kind, int type)
+        {
+            table[static_cast<unsigned char>(glyph)] = TileAction{false, true, kind, static_cast<std::uint8_t>(type)};
+        };
+
+        set('@', FloorSpawn::PLAYER, 0);
+        // enemy glyphs are game data
+        for (std::size_t kind = 0; kind < std::size_t(EnemyKind::COUNT); kind++)
+        {
+            set(traitsOf(EnemyKind(kind)).display, FloorSpawn::ENEMY, kind);
+        }
+        for (std::size_t kind = 0; kind < std::size_t(PotionKind::COUNT); kind++)
+        {
+            set('0' + kind, FloorSpawn::POTION, kind);
+        }
+        set('6', FloorSpawn::TREASURE, 1);
+        set('7', FloorSpawn::TREASURE, 2);
+        set('8', FloorSpawn::TREASURE, 4);
+        set('9', FloorSpawn::HOARD, 6);
+        // treasure is spelled with the digits above
+        for (std::size_t kind = std::size_t(ItemKind::TREASURE) + 1; kind < std::size_t(ItemKind::COUNT); kind++)
+        {
+            set(traitsOf(ItemKind(kind)).display, FloorSpawn::ITEM, kind);
+        }
+        return table;
+    }
+
+    std::string describe(char tile)
+    {
+        if (std::isprint(static_cast<unsigned char>(tile)))
+        {
+            return std::string("'") + tile + "'";
+        }
+        return "byte " + std::to_string(static_cast<unsigned char>(tile));
+    }
+
+    void fail(const std::string &source, int line, int column, const std::string &what)
+    {
+        throw source + ":" + std::to_string(line) + ":" + std::to_string(column) + ": " + what;
+    }
+
+    // whether any line up to end is empty, which makes blank lines the floor separator
+    bool hasBlankLine(const char *text, const char *end)
+    {
+        while (text < end)
+        {
+            const char *lineEnd = static_cast<const char *>(std::memchr(text, '\n', end - text));
+            if (!lineEnd)
+            {
+                return false;
+            }
+            if (lineEnd == text || (lineEnd == text + 1 && *text == '\r'))
+            {
+                return true;
+            }
+            text = lineEnd + 1;
+        }
+        return false;
+    }
+
+    bool guardable(const FloorSpawn &spawn)
+    {
+        return spawn.kind == FloorSpawn::HOARD || (spawn.kind == FloorSpawn::ITEM && spawn.type == std::uint8_t(ItemKind::BARRIER_SUIT));
+    }
+
+    // scratch space of guardHoards, reused from floor to floor
+    struct GuardMatching
+    {
+        struct Step
+        {
+            int dragon; // spawn index
+            int bit;    // next neighbour to try
+            int hoard;  // spawn index of the neighbour tried last
+        };
+
+        std::vector<int> guardedBy; // per spawn of the floor, the dragon guarding it, -1 for none
+        std::vector<int> visited;   // per spawn, the search that last reached it
+        std::vector<Step> path;
+    };
+
+    // Gives every dragon of the floor being parsed a hoard or barrier suit next to it that no other
+    // dragon guards, a bipartite matching found with augmenting paths: a dragon with no free
+    // neighbour takes one from a dragon that can move on to another, as far down the chain as it
+    // takes. A dragon left without one cannot be given one by any assignment. spawnAt maps the
+    // floor's cells to its spawns and is left all -1 again.
+    void guardHoards(FloorFile &floors, int height, int width, std::vector<int> &spawnAt, GuardMatching &matching,
+                     const std::string &source, int firstLine)
+    {
+        FloorSpawn *spawns = floors.spawns.data() + floors.offsets.back();
+        int count = floors.spawns.size() - floors.offsets.back();
+
+        // the guardable spawn next to dragon in direction bit, -1 for none
+        auto hoardNear = [spawns, height, width, &spawnAt](int dragon, int bit)
+        {
+            int row = spawns[dragon].row + DIRECTION_ROW[bit];
+            int col = spawns[dragon].col + DIRECTION_COL[bit];
+            if (row < 0 || row >= height || col < 0 || col >= width)
+            {
+                return -1;
+            }
+            int spawn = spawnAt[row * width + col];
+            return spawn >= 0 && guardable(spawns[spawn]) ? spawn : -1;
+        };
+
+        matching.guardedBy.assign(count, -1);
+        matching.visited.assign(count, -1);
+        for (int dragon = 0; dragon < count; dragon++)
+        {
+            if (spawns[dragon].kind != FloorSpawn::ENEMY || spawns[dragon].type != std::uint8_t(EnemyKind::DRAGON))
+            {
+                continue;
+            }
+
+            // depth-first search for a free hoard, each step moving on to the dragon that guards
+            // the hoard tried; a hoard is tried once per search
+            std::vector<GuardMatching::Step> &path = matching.path;
+            path.assign(1, GuardMatching::Step{dragon, 0, -1});
+            bool found = false;
+            while (!path.empty() && !found)
+            {
+                GuardMatching::Step &step = path.back();
+                if (step.bit == 8)
+                {
+                    path.pop_back();
+                    continue;
+                }
+                int hoard = hoardNear(step.dragon, step.bit++);
+                if (hoard < 0 || matching.visited[hoard] == dragon)
+                {
+                    continue;
+                }
+                matching.visited[hoard] = dragon;
+                step.hoard = hoard;
+                found = matching.guardedBy[hoard] < 0;
+                if (!found)
+                {
+                    path.push_back(GuardMatching::Step{matching.guardedBy[hoard], 0, -1});
+                }
+            }
+            if (!found)
+            {
+                fail(source, firstLine + spawns[dragon].row, spawns[dragon].col + 1, "dragon has no hoard or barrier suit of its own next to it");
+            }
+            // every dragon on the path moves to the hoard it was tried on
+            for (const GuardMatching::Step &step : path)
+            {
+                matching.guardedBy[step.hoard] = step.dragon;
+            }
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            if (matching.guardedBy[i] >= 0)
+            {
+                FloorSpawn &dragon = spawns[matching.guardedBy[i]];
+                dragon.guardRow = spawns[i].row;
+                dragon.guardCol = spawns[i].col;
+            }
+            spawnAt[spawns[i].row * width + spawns[i].col] = -1;
+        }
+    }
+}
+
+FloorFile parseFloorFile(const char *text, std::size_t size, const std::string &source)
+{
+    const TileTable table = tileTable();
+
+    // blank lines after the last floor are fine
+    const char *end = text + size;
+    while (end > text && (end[-1] == '\n' || end[-1] == '\r'))
+    {
+        end--;
+    }
+
+    const char *cursor = text;
+    int line = 0;
+    // the next line without its line break
+    auto nextLine = [&cursor, &line, end](std::size_t &length)
+    {
+        const char *start = cursor;
+        const char *lineEnd = static_cast<const char *>(std::memchr(cursor, '\n', end - cursor));
+        if (!lineEnd)
+        {
+            lineEnd = end;
+        }
+        length = lineEnd - start;
+        if (length > 0 && start[length - 1] == '\r')
+        {
+            length--;
+        }
+        cursor = lineEnd < end ? lineEnd + 1 : end;
+        line++;
+        return start;
+    };
+
+    // Files with blank lines end a floor at one, so a floor may hold a wall row as wide as it is.
+    // Without any, floors are back to back as in the stock file, and a floor ends with the line
+    // that repeats its top wall.
+    const bool blankSeparated = hasBlankLine(text, end);
+
+    FloorFile floors;
+    floors.hash = fnv1a(text, size);
+    std::vector<std::string> layout;
+    std::shared_ptr<const FloorMap> map = boardMap();
+    std::vector<int> spawnAt; // spawn of each cell of the current floor, -1 for none
+    GuardMatching matching;
+    while (cursor < end)
+    {
+        // any number of blank lines between floors
+        std::size_t width;
+        const char *top = nextLine(width);
+        if (width == 0)
+        {
+            continue;
+        }
+        int floor = floors.count() + 1;
+        int firstLine = line;
+
+        // the top wall sets the width, and the floor ends at the next blank line or the end of the
+        // file, or where the top wall comes round again
+        if (width < 3 || width > static_cast<std::size_t>(MAX_FLOOR_SIZE))
+        {
+            fail(source, line, 1, "floors are 3 to " + std::to_string(MAX_FLOOR_SIZE) + " columns wide, found " + std::to_string(width));
+        }
+
+        layout.clear();
+        bool player = false;
+        const char *bottom = top; // as written, layout has the entities replaced
+        bool closed = false;
+        for (int row = 0; !closed; row++)
+        {
+            const char *tiles = top;
+            if (row > 0)
+            {
+                if (cursor >= end)
+                {
+                    if (!blankSeparated)
+                    {
+                        fail(source, line + 1, 1, "file ends before the bottom wall of floor " + std::to_string(floor));
+                    }
+                    break;
+                }
+                std::size_t length;
+                tiles = nextLine(length);
+                if (length == 0)
+                {
+                    break;
+                }
+                if (length != width)
+                {
+                    fail(source, line, 1, "expected " + std::to_string(width) + " columns like the top wall, found " + std::to_string(length));
+                }
+                closed = !blankSeparated && std::memcmp(tiles, top, width) == 0;
+            }
+            if (row >= MAX_FLOOR_SIZE)
+            {
+                fail(source, line, 1, "floor " + std::to_string(floor) + " is more than " + std::to_string(MAX_FLOOR_SIZE) + " lines long");
+            }
+            if (spawnAt.size() < (row + 1) * width)
+            {
+                spawnAt.resize((row + 1) * width, -1);
+            }
+
+            bottom = tiles;
+            layout.emplace_back(tiles, width);
+            std::string &tileRow = layout.back();
+            for (std::size_t col = 0; col < width; col++)
+            {
+                const TileAction &action = table[static_cast<unsigned char>(tileRow[col])];
+                if (action.layout)
+                {
+                    continue;
+                }
+                if (!action.spawns)
+                {
+                    fail(source, line, col + 1, "unknown glyph " + describe(tileRow[col]));
+                }
+                if (row == 0)
+                {
+                    fail(source, line, col + 1, describe(tileRow[col]) + " in the top wall");
+                }
+                if (col == 0 || col == width - 1)
+                {
+                    fail(source, line, col + 1, describe(tileRow[col]) + " in the " + (col == 0 ? "left" : "right") + " wall");
+                }
+                if (action.kind == FloorSpawn::PLAYER)
+                {
+                    if (player)
+                    {
+                        fail(source, line, col + 1, "second player on floor " + std::to_string(floor));
+                    }
+                    player = true;
+                }
+                // a glyph hides the tile under it, and entities only ever stand on room floor inside
+                // the outer walls
+                tileRow[col] = '.';
+                spawnAt[row * width + col] = floors.spawns.size() - floors.offsets.back();
+                floors.spawns.push_back(FloorSpawn{action.kind, action.type, static_cast<std::uint16_t>(row), static_cast<std::uint16_t>(col), 0, 0});
+            }
+        }
+
+        int height = layout.size();
+        if (height < 3)
+        {
+            fail(source, firstLine, 1, "floor " + std::to_string(floor) + " needs a top wall, a bottom wall and a row in between");
+        }
+        for (std::size_t col = 0; col < width; col++)
+        {
+            if (!table[static_cast<unsigned char>(bottom[col])].layout)
+            {
+                fail(source, firstLine + height - 1, col + 1, describe(bottom[col]) + " in the bottom wall");
+            }
+        }
+        if (!player)
+        {
+            fail(source, firstLine, 1, "floor " + std::to_string(floor) + " has no player");
+        }
+        guardHoards(floors, height, width, spawnAt, matching, source, firstLine);
+        floors.offsets.push_back(floors.spawns.size());
+
+        // a run of floors on one layout shares a single map
+        if (layout != map->getLayout())
+        {
+            map = layout == boardMap()->getLayout() ? boardMap() : std::make_shared<const FloorMap>(std::move(layout));
+        }
+        floors.maps.push_back(map);
+    }
+    return floors;
+}
+
+FloorFile loadFloorFile(const std::string &path)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw "Cannot open floor file " + path;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        throw "Cannot read floor file " + path;
+    }
+    if (info.st_size == 0)
+    {
+        close(fd);
+        return parseFloorFile("", 0, path);
+    }
+
+    std::size_t size = info.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+        throw "Cannot map floor file " + path;
+    }
+    madvise(mapped, size, MADV_SEQUENTIAL);
+
+    try
+    {
+        FloorFile floors = parseFloorFile(static_cast<const char *>(mapped), size, path);
+        munmap(mapped, size);
+        return floors;
+    }
+    catch (...)
+    {
+        munmap(mapped, size);
+        throw;
+    }
+}
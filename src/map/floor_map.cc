@@ -0,0 +1,46 @@
+#include "map/floor_map.h"
+#include "constants/constants.h"
+
+namespace
+{
+    template <typename Predicate>
+    Bitboard layoutMask(const std::vector<std::string> &layout, int width, Predicate walkable)
+    {
+        Bitboard mask(layout.size(), width);
+        for (int row = 0; row < static_cast<int>(layout.size()); row++)
+        {
+            for (int col = 0; col < width; col++)
+            {
+                if (walkable(layout[row][col]))
+                {
+                    mask.set(row, col);
+                }
+            }
+        }
+        return mask;
+    }
+}
+
+FloorMap::FloorMap(std::vector<std::string> lines)
+    : height{static_cast<int>(lines.size())}, width{lines.empty() ? 0 : static_cast<int>(lines[0].size())}, layout{std::move(lines)}
+{
+    playerCells = layoutMask(layout, width, [](char tile)
+                             { return tile != '|' && tile != '-' && tile != ' '; });
+    enemyCells = layoutMask(layout, width, [](char tile)
+                            { return tile != '|' && tile != '-' && tile != ' ' && tile != '+'; });
+    floorCells = layoutMask(layout, width, [](char tile)
+                            { return tile == '.'; });
+}
+
+const RoomTable &FloorMap::rooms() const
+{
+    std::call_once(roomsFound, [this]()
+                   { roomTable = findRooms(layout); });
+    return roomTable;
+}
+
+const std::shared_ptr<const FloorMap> &boardMap()
+{
+    static const std::shared_ptr<const FloorMap> map = std::make_shared<const FloorMap>(BOARD);
+    return map;
+}
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include "map/flow_field.h"
+
+const std::uint32_t FlowField::UNREACHABLE;
+
+bool FlowField::update(const Bitboard &mask, int row, int col, std::uint32_t maxDistance)
+{
+    if (&mask == walkable && row == targetRow && col == targetCol && maxDistance == range)
+    {
+        return false;
+    }
+    walkable = &mask;
+    targetRow = row;
+    targetCol = col;
+    range = maxDistance;
+    width = mask.width();
+
+    std::size_t cells = static_cast<std::size_t>(mask.height()) * width;
+    if (steps.size() != cells)
+    {
+        steps.assign(cells, Step{0, UNREACHABLE});
+        generation = 0;
+    }
+    if (++generation == 0)
+    {
+        // wrapped after four billion searches, old stamps could read as current
+        std::fill(steps.begin(), steps.end(), Step{0, UNREACHABLE});
+        generation = 1;
+    }
+    if (row < 0 || row >= mask.height() || col < 0 || col >= width)
+    {
+        return true;
+    }
+
+    // breadth first, so every cell is final the first time it is reached
+    frontier.clear();
+    steps[row * width + col] = Step{generation, 0};
+    frontier.push_back(row << 16 | col);
+    for (std::size_t next = 0; next < frontier.size(); next++)
+    {
+        int cellRow = frontier[next] >> 16;
+        int cellCol = frontier[next] & 0xffff;
+        std::uint32_t distance = steps[cellRow * width + cellCol].distance + 1;
+        if (distance > range)
+        {
+            // the frontier only grows further from here
+            break;
+        }
+        for (std::uint32_t bits = mask.neighbours(cellRow, cellCol); bits; bits &= bits - 1)
+        {
+            int bit = __builtin_ctz(bits);
+            int nextRow = cellRow + DIRECTION_ROW[bit];
+            int nextCol = cellCol + DIRECTION_COL[bit];
+            Step &step = steps[nextRow * width + nextCol];
+            if (step.stamp != generation)
+            {
+                step = Step{generation, distance};
+                frontier.push_back(nextRow << 16 | nextCol);
+            }
+        }
+    }
+    return true;
+}
+
+std::uint32_t FlowField::distanceAt(int row, int col) const
+{
+    if (!walkable || row < 0 || row >= walkable->height() || col < 0 || col >= width)
+    {
+        return UNREACHABLE;
+    }
+    const Step &step = steps[row * width + col];
+    return step.stamp == generation ? step.distance : UNREACHABLE;
+}
+
+std::uint8_t FlowField::closerNeighbours(int row, int col, std::uint8_t candidates) const
+{
+    const std::uint32_t here = distanceAt(row, col);
+    std::uint32_t best = here;
+    std::uint8_t closest = 0;
+    for (std::uint32_t bits = candidates; bits; bits &= bits - 1)
+    {
+        int bit = __builtin_ctz(bits);
+        std::uint32_t distance = distanceAt(row + DIRECTION_ROW[bit], col + DIRECTION_COL[bit]);
+        if (distance < best)
+        {
+            best = distance;
+            closest = 1 << bit;
+        }
+        else if (distance == best && best < here)
+        {
+            closest |= 1 << bit;
+        }
+    }
+    return closest;
+}
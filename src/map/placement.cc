@@ -0,0 +1,103 @@
+#include <utility>
+#include "map/placement.h"
+#include "game/rng.h"
+#include "map/rooms.h"
+
+Placement::Placement(const RoomTable &rooms, int height, int width)
+    : width{width}, offsets{rooms.offsets}, cells{rooms.cells}, freeCount(rooms.count()), roomOf(height * width, -1), slotOf(height * width, -1)
+{
+    for (int room = 0; room < roomCount(); room++)
+    {
+        freeCount[room] = rooms.size(room);
+        for (int slot = 0; slot < rooms.size(room); slot++)
+        {
+            const Cell &cell = rooms.cell(room, slot);
+            roomOf[cell.first * width + cell.second] = room;
+            slotOf[cell.first * width + cell.second] = slot;
+        }
+    }
+    candidates.reserve(rooms.count());
+}
+
+void Placement::reset()
+{
+    while (!taken.empty())
+    {
+        int room = taken.back().first;
+        int slot = taken.back().second;
+        swapCells(room, slot, freeCount[room]);
+        freeCount[room]++;
+        taken.pop_back();
+    }
+}
+
+int Placement::roomCount() const
+{
+    return freeCount.size();
+}
+
+int Placement::roomAt(int row, int col) const
+{
+    if (row < 0 || col < 0 || col >= width || row * width + col >= static_cast<int>(roomOf.size()))
+    {
+        return -1;
+    }
+    return roomOf[row * width + col];
+}
+
+std::size_t Placement::freeCells(int room) const
+{
+    return freeCount[room];
+}
+
+void Placement::swapCells(int room, int a, int b)
+{
+    Cell *roomCells = &cells[offsets[room]];
+    std::swap(roomCells[a], roomCells[b]);
+    slotOf[roomCells[a].first * width + roomCells[a].second] = a;
+    slotOf[roomCells[b].first * width + roomCells[b].second] = b;
+}
+
+void Placement::remove(int room, int slot)
+{
+    // the last free cell fills the hole
+    freeCount[room]--;
+    swapCells(room, slot, freeCount[room]);
+    taken.emplace_back(room, slot);
+}
+
+std::pair<int, int> Placement::take(Rng &rng, int excludedRoom)
+{
+    candidates.clear();
+    for (int room = 0; room < roomCount(); room++)
+    {
+        if (room != excludedRoom && freeCount[room] > 0)
+        {
+            candidates.push_back(room);
+        }
+    }
+    if (candidates.empty())
+    {
+        throw "No free cell left to spawn in";
+    }
+
+    int room = candidates[rng.below(candidates.size())];
+    int slot = rng.below(freeCount[room]);
+    Cell cell = cells[offsets[room] + slot];
+    remove(room, slot);
+    return cell;
+}
+
+void Placement::claim(int row, int col)
+{
+    int room = roomAt(row, col);
+    if (room < 0)
+    {
+        return;
+    }
+    int slot = slotOf[row * width + col];
+    if (slot < static_cast<int>(freeCount[room]))
+    {
+        remove(room, slot);
+    }
+}
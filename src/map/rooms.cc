@@ -0,0 +1,79 @@
+#include <algorithm>
+#include "map/rooms.h"
+
+namespace
+{
+    bool isRoomCell(char tile)
+    {
+        return tile != '|' && tile != '-' && tile != '+' && tile != '#' && tile != ' ';
+    }
+}
+
+RoomTable findRooms(const std::vector<std::string> &layout)
+{
+    int height = layout.size();
+    int width = 0;
+    for (const std::string &line : layout)
+    {
+        width = std::max(width, static_cast<int>(line.size()));
+    }
+
+    // label every room cell with its room, growing each room from its first cell
+    std::vector<int> label(height * width, -1);
+    std::vector<int> stack;
+    std::vector<int> sizes;
+    for (int start = 0; start < height * width; start++)
+    {
+        int row = start / width;
+        int col = start % width;
+        if (label[start] >= 0 || col >= static_cast<int>(layout[row].size()) || !isRoomCell(layout[row][col]))
+        {
+            continue;
+        }
+
+        int room = sizes.size();
+        sizes.push_back(0);
+        label[start] = room;
+        stack.push_back(start);
+        while (!stack.empty())
+        {
+            int cell = stack.back();
+            stack.pop_back();
+            sizes[room]++;
+
+            const int rowStep[] = {-1, 1, 0, 0};
+            const int colStep[] = {0, 0, -1, 1};
+            for (int i = 0; i < 4; i++)
+            {
+                int r = cell / width + rowStep[i];
+                int c = cell % width + colStep[i];
+                if (r < 0 || r >= height || c < 0 || c >= static_cast<int>(layout[r].size()))
+                {
+                    continue;
+                }
+                if (label[r * width + c] < 0 && isRoomCell(layout[r][c]))
+                {
+                    label[r * width + c] = room;
+                    stack.push_back(r * width + c);
+                }
+            }
+        }
+    }
+
+    // a counting sort by room keeps every room's cells in row-major order
+    RoomTable rooms;
+    for (int size : sizes)
+    {
+        rooms.offsets.push_back(rooms.offsets.back() + size);
+    }
+    rooms.cells.resize(rooms.offsets.back());
+    std::vector<int> next(rooms.offsets.begin(), rooms.offsets.end() - 1);
+    for (int cell = 0; cell < height * width; cell++)
+    {
+        if (label[cell] >= 0)
+        {
+            rooms.cells[next[label[cell]]++] = std::make_pair(cell / width, cell % width);
+        }
+    }
+    return rooms;
+}
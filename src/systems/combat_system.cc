@@ -5,153 +5,155 @@
 #include "systems/combat_system.h"
 #include "entities/entity_manager.h"
 #include "constants/constants.h"
-#include "globals/global.h"
+#include "constants/game_data.h"
+#include "game/game_context.h"
 using namespace std;
 
-void CombatSystem::update(EntityManager &entities, shared_ptr<Entity> player)
+namespace
 {
-    if (player->getComponent<ActionComponent>()->attack)
+    // what is left of a slain enemy that stays on the map as an item is not a fighter any more
+    void dropEnemyComponents(Entity target)
     {
-        battle(entities, player, player->getComponent<DirectionComponent>()->direction);
+        target.removeComponent<EnemyTypeComponent>();
+        target.removeComponent<DisplayComponent>();
+        target.removeComponent<HealthComponent>();
+        target.removeComponent<AttackComponent>();
+        target.removeComponent<DefenseComponent>();
     }
-    enemies_attack(entities, *player);
 }
 
-void CombatSystem::battle(EntityManager &entities, shared_ptr<Entity> player, const string &direction)
-{
-    const int pCol = player->getComponent<PositionComponent>()->col;
-    const int pRow = player->getComponent<PositionComponent>()->row;
-    shared_ptr<Entity> target;
+CombatSystem::CombatSystem(GameContext &context) : context{context} {}
 
-    // Get target
-    try
-    {
-        target = entities.getEntity(pRow + DIRECTION_MAP.at(direction).first, pCol + DIRECTION_MAP.at(direction).second);
-    }
-    catch (exception e)
+void CombatSystem::update(EntityManager &entities, Entity player)
+{
+    if (player.getComponent<ActionComponent>()->attack)
     {
-        throw "Not a valid direction!";
+        battle(entities, player, player.getComponent<DirectionComponent>()->direction);
     }
+    enemies_attack(entities, player);
+}
+
+void CombatSystem::battle(EntityManager &entities, Entity player, Direction direction)
+{
+    const int pCol = player.getComponent<PositionComponent>()->col;
+    const int pRow = player.getComponent<PositionComponent>()->row;
+    Entity target = entities.getEntity(pRow + DIRECTION_ROW[size_t(direction)], pCol + DIRECTION_COL[size_t(direction)]);
 
     if (!target)
     {
-        actionMessage.push_back("PC attacked " + direction + " but nothing was there...");
+        context.actionMessage.push_back("PC attacked " + string(nameOf(direction)) + " but nothing was there...");
         return;
     }
 
-    attack(*player, *target);
+    // potions, gold and items sit on the map too but cannot be fought, nor can the
+    // compass or gold a slain enemy turned into
+    if (!target.hasComponent<EnemyTypeComponent>())
+    {
+        throw "Cannot attack that!";
+    }
+
+    attack(player, target);
 
     // check if target died
-    if (!checkDeath(*target))
+    if (!checkDeath(target))
     {
         return;
     }
 
     // if merchant, change him to a gold pile
-    if (target->getComponent<EnemyTypeComponent>()->enemy_type == "merchant")
+    if (target.getComponent<EnemyTypeComponent>()->enemy_type == EnemyKind::MERCHANT)
     {
         // if he is non hostile, change all merchants to hostile
-        target->removeComponent<EnemyTypeComponent>();
-        target->removeComponent<DisplayComponent>();
-        target->addComponent(std::make_shared<DisplayComponent>('G'));
-        target->addComponent(std::make_shared<TreasureComponent>(4));
-        target->addComponent(std::make_shared<ItemTypeComponent>("treasure"));
-        target->addComponent(std::make_shared<CanPickupComponent>());
+        dropEnemyComponents(target);
+        target.addComponent(DisplayComponent(traitsOf(ItemKind::TREASURE).display));
+        target.addComponent(TreasureComponent(4));
+        target.addComponent(ItemTypeComponent(ItemKind::TREASURE));
+        target.addComponent(CanPickupComponent());
         return;
     }
 
     // if dragon, then make the treasure it's guarding pick uppable
-    if (target->getComponent<EnemyTypeComponent>()->enemy_type == "dragon")
+    if (target.getComponent<EnemyTypeComponent>()->enemy_type == EnemyKind::DRAGON)
     {
-        std::shared_ptr<GuardingPositionComponent> pos = target->getComponent<GuardingPositionComponent>();
-        std::shared_ptr<Entity> treasure = entities.getEntity(pos->row, pos->col);
-        treasure->addComponent(std::make_shared<CanPickupComponent>());
+        GuardingPositionComponent *pos = target.getComponent<GuardingPositionComponent>();
+        Entity treasure = entities.getEntity(pos->row, pos->col);
+        if (treasure && treasure.hasComponent<ItemTypeComponent>())
+        {
+            treasure.addComponent(CanPickupComponent());
+        }
     }
 
     // if enemy holds compass, turn him into the compass
-    if (target->getComponent<CompassComponent>())
+    if (target.hasComponent<CompassComponent>())
     {
-        target->removeComponent<EnemyTypeComponent>();
-        target->removeComponent<DisplayComponent>();
-        target->addComponent(std::make_shared<DisplayComponent>('C'));
-        target->addComponent(std::make_shared<ItemTypeComponent>("compass"));
-        target->addComponent(std::make_shared<CanPickupComponent>());
+        dropEnemyComponents(target);
+        target.addComponent(DisplayComponent(traitsOf(ItemKind::COMPASS).display));
+        target.addComponent(ItemTypeComponent(ItemKind::COMPASS));
+        target.addComponent(CanPickupComponent());
     }
 
-    if (target->getComponent<GoldComponent>())
+    if (target.hasComponent<GoldComponent>())
     {
-        float gold = target->getComponent<GoldComponent>()->gold;
-        if (player->getComponent<GoldMultiplierComponent>())
+        float gold = target.getComponent<GoldComponent>()->gold;
+        if (player.hasComponent<GoldMultiplierComponent>())
         {
-            gold *= player->getComponent<GoldMultiplierComponent>()->percent;
+            gold *= player.getComponent<GoldMultiplierComponent>()->percent;
         }
-        player->getComponent<GoldComponent>()->gold += gold;
+        player.getComponent<GoldComponent>()->gold += gold;
     }
 
-    if (target->getComponent<EnemyTypeComponent>())
+    if (target.hasComponent<EnemyTypeComponent>())
     {
         entities.removeEntity(target);
     }
 }
 
-void CombatSystem::enemies_attack(EntityManager &entities, Entity &player)
+void CombatSystem::enemies_attack(EntityManager &entities, Entity player)
 {
     const int pCol = player.getComponent<PositionComponent>()->col;
     const int pRow = player.getComponent<PositionComponent>()->row;
-    vector<shared_ptr<Entity>> enemies;
-
-    for (int i = -1; i <= 1; i++)
-    {
-        for (int j = -1; j <= 1; j++)
-        {
-            if (i == j && i == 0)
-            {
-                continue;
-            }
-            enemies.push_back(entities.getEntity(pRow + i, pCol + j));
-        }
-    }
+    std::array<Entity, 8> enemies = entities.getNeighbours(pRow, pCol);
 
     for (auto &enemy : enemies)
     {
-        if (!enemy || !enemy->getComponent<EnemyTypeComponent>())
+        if (!enemy || !enemy.hasComponent<EnemyTypeComponent>())
         {
             continue;
         }
         // if no merchant has died, continue
-        if (enemy->getComponent<EnemyTypeComponent>()->enemy_type == "merchant" && !merchantHostile)
+        if (enemy.getComponent<EnemyTypeComponent>()->enemy_type == EnemyKind::MERCHANT && !context.merchantHostile)
         {
             continue;
         }
 
         // if dragon, and not next to guard, continue
-        if (enemy->getComponent<EnemyTypeComponent>()->enemy_type == "dragon")
+        if (enemy.getComponent<EnemyTypeComponent>()->enemy_type == EnemyKind::DRAGON)
         {
-            std::shared_ptr<GuardingPositionComponent> pos = enemy->getComponent<GuardingPositionComponent>();
+            GuardingPositionComponent *pos = enemy.getComponent<GuardingPositionComponent>();
             if (abs(pCol - pos->col) > 1 || abs(pRow - pos->row) > 1)
             {
                 continue;
             }
         }
 
-        if (random() % 2 == 0)
+        if (context.combatRng.below(2) == 0)
         {
-            attack(*enemy, player);
+            attack(enemy, player);
         }
         else
         {
-            actionMessage.push_back(enemy->getComponent<EnemyTypeComponent>()->enemy_type + " missed the player!");
+            context.actionMessage.push_back(std::string(traitsOf(enemy.getComponent<EnemyTypeComponent>()->enemy_type).name) + " missed the player!");
         }
     }
 }
 
-bool CombatSystem::checkDeath(Entity &e)
+bool CombatSystem::checkDeath(Entity e)
 {
     auto health = e.getComponent<HealthComponent>();
     return health->currentHealth <= 0;
 }
 
-void CombatSystem::attack(Entity &attacker, Entity &defender)
+void CombatSystem::attack(Entity attacker, Entity defender)
 {
     // assumes we know who is attacking & defending
     // check if they have component before accessing
@@ -174,43 +176,45 @@ void CombatSystem::attack(Entity &attacker, Entity &defender)
 
     int damage = ceil((100.0) / (100 + defense)) * (attack);
 
-    if (defender.getComponent<BarrierSuitComponent>())
+    if (defender.hasComponent<BarrierSuitComponent>())
     {
         damage = ceil(damage / 2);
     }
 
     // check for abilities
-    if (attacker.getComponent<GoldStealComponent>())
+    if (attacker.hasComponent<GoldStealComponent>())
     {
         goldsteal(attacker, defender);
     }
 
-    if (attacker.getComponent<LifestealComponent>())
+    if (attacker.hasComponent<LifestealComponent>())
     {
         lifesteal(attacker, damage);
     }
 
     health -= damage;
-    if (attacker.getComponent<PlayerRaceComponent>())
+    if (attacker.hasComponent<PlayerRaceComponent>())
     {
-        actionMessage.push_back("PC deals " + to_string(damage) + " to " +
-                                defender.getComponent<EnemyTypeComponent>()->enemy_type + " (" + to_string(health) + " HP).");
+        context.actionMessage.push_back("PC deals " + to_string(damage) + " to " +
+                                traitsOf(defender.getComponent<EnemyTypeComponent>()->enemy_type).name + " (" + to_string(health) + " HP).");
 
-        if (defender.getComponent<EnemyTypeComponent>()->enemy_type == "merchant")
+        if (defender.getComponent<EnemyTypeComponent>()->enemy_type == EnemyKind::MERCHANT)
         {
-            merchantHostile = true;
+            context.merchantHostile = true;
         }
     }
     else
     {
-        actionMessage.push_back(attacker.getComponent<EnemyTypeComponent>()->enemy_type + " deals " + to_string(damage) + " to PC.");
+        context.lastAttacker = attacker.getComponent<EnemyTypeComponent>()->enemy_type;
+        context.actionMessage.push_back(traitsOf(context.lastAttacker).name + (" deals " + to_string(damage) + " to PC."));
     }
 }
 
-void CombatSystem::goldsteal(Entity &attacker, Entity &target)
+
+void CombatSystem::goldsteal(Entity attacker, Entity target)
 {
     // if the target doesn't have any gold, return
-    if (!target.getComponent<GoldComponent>())
+    if (!target.hasComponent<GoldComponent>())
     {
         return;
     }
@@ -221,7 +225,7 @@ void CombatSystem::goldsteal(Entity &attacker, Entity &target)
     target.getComponent<GoldComponent>()->gold -= amount;
 }
 
-void CombatSystem::lifesteal(Entity &attacker, int damage)
+void CombatSystem::lifesteal(Entity attacker, int damage)
 {
     auto health = attacker.getComponent<HealthComponent>();
     const auto lifesteal = attacker.getComponent<LifestealComponent>();
@@ -1,97 +1,276 @@
+#include <algorithm>
+#include <csignal>
+#include <cerrno>
+#include <cstdio>
+#include <unistd.h>
 #include "systems/display_system.h"
 #include "constants/constants.h"
+#include "constants/game_data.h"
 #include "constants/colours.h"
 #include "entities/entity.h"
 #include "entities/entity_manager.h"
 #include "components/components.h"
-#include "globals/global.h"
+#include "game/game_context.h"
+#include "systems/vision_system.h"
 
-void DisplaySystem::outputColor(char c)
+namespace
 {
-    if (c == '|' || c == '-' || c == '+' || c == '#' || c == ' ')
-        std::cout << MAG;
-    else if (c == '.')
-        std::cout << MAG;
-    else if (c == 'G')
-        std::cout << BHYEL;
-    else if (c == 'C' || c == 'B')
-        std::cout << BHGRN;
-    else if (c == '@' || c == '\\')
-        std::cout << BHWHT;
+    volatile std::sig_atomic_t terminalResized = 0;
+
+    void onResize(int)
+    {
+        terminalResized = 1;
+    }
+}
+
+// a full redraw with a colour change on every cell, plus the status lines
+const std::size_t FRAME_BUFFER_CAPACITY = 16 * FLOOR_HEIGHT * FLOOR_WIDTH;
+
+DisplaySystem::DisplaySystem(GameContext &context) : context{context}
+{
+    frameBuffer.reserve(FRAME_BUFFER_CAPACITY);
+#ifdef SIGWINCH
+    std::signal(SIGWINCH, onResize);
+#endif
+}
+
+const char *DisplaySystem::colorOf(char c)
+{
+    if (c == '|' || c == '-' || c == '+' || c == '#' || c == ' ' || c == '.')
+        return MAG;
+    else if (c == traitsOf(ItemKind::TREASURE).display)
+        return BHYEL;
+    else if (c == traitsOf(ItemKind::COMPASS).display || c == traitsOf(ItemKind::BARRIER_SUIT).display)
+        return BHGRN;
+    else if (c == '@' || c == traitsOf(ItemKind::STAIRS).display)
+        return BHWHT;
     else if (c == 'P')
-        std::cout << BHCYN;
-    else if (c == 'V' || c == 'W' || c == 'N' || c == 'M' || c == 'D' || c == 'X' || c == 'T')
-        std::cout << BHRED;
-    std::cout << c << COLOR_RESET;
+        return BHCYN;
+    // enemy glyphs are game data, and no two enemies or other glyphs share one
+    for (std::size_t kind = 0; kind < std::size_t(EnemyKind::COUNT); kind++)
+    {
+        if (c == traitsOf(EnemyKind(kind)).display)
+            return BHRED;
+    }
+    return COLOR_RESET;
+}
+
+void DisplaySystem::emit(const char *text)
+{
+    frameBuffer.append(text);
+}
+
+void DisplaySystem::emit(const std::string &text)
+{
+    frameBuffer.append(text);
+}
+
+void DisplaySystem::emit(int number)
+{
+    char digits[16];
+    int length = std::snprintf(digits, sizeof(digits), "%d", number);
+    frameBuffer.append(digits, length);
+}
+
+void DisplaySystem::flush()
+{
+    // anything still sitting in cout was written before this frame
+    std::cout.flush();
+    const char *data = frameBuffer.data();
+    std::size_t remaining = frameBuffer.size();
+    while (remaining > 0)
+    {
+        ssize_t written = ::write(STDOUT_FILENO, data, remaining);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        data += written;
+        remaining -= written;
+    }
+}
+
+void DisplaySystem::emitCell(int row, int col, char c)
+{
+    // move the cursor only when the cell does not directly follow the last one written
+    if (row != cursorRow || col != cursorCol)
+    {
+        if (col == 0 && row == cursorRow + 1)
+        {
+            emit("\n");
+        }
+        else
+        {
+            emit("\e[");
+            emit(row + 1);
+            emit(";");
+            emit(col + 1);
+            emit("H");
+        }
+    }
+
+    const char *color = colorOf(c);
+    if (color != activeColor)
+    {
+        emit(color);
+        activeColor = color;
+    }
+
+    frameBuffer.push_back(c);
+    cursorRow = row;
+    cursorCol = col + 1;
 }
 
-void DisplaySystem::update(EntityManager &entityManager, std::shared_ptr<Entity> player, int floor)
+void DisplaySystem::composeFrame(EntityManager &entityManager, Entity player)
 {
-    for (int row = 0; row < BOARD.size(); row++)
+    // a bigger map scrolls to keep the player in the middle of the screen
+    const FloorMap &map = entityManager.getMap();
+    PositionComponent *position = player.getComponent<PositionComponent>();
+    viewHeight = std::min(map.getHeight(), FLOOR_HEIGHT);
+    viewWidth = std::min(map.getWidth(), FLOOR_WIDTH);
+    viewRow = std::max(0, std::min(position->row - viewHeight / 2, map.getHeight() - viewHeight));
+    viewCol = std::max(0, std::min(position->col - viewWidth / 2, map.getWidth() - viewWidth));
+
+    const bool fog = vision && vision->isEnabled();
+    currentFrame.clear();
+    for (int row = viewRow; row < viewRow + viewHeight; row++)
     {
-        for (int col = 0; col < BOARD.at(row).size(); col++)
+        for (int col = viewCol; col < viewCol + viewWidth; col++)
         {
-            std::shared_ptr<Entity> entity = entityManager.getEntity(row, col);
-            if (entity)
+            char c = map.tile(row, col);
+            if (fog && !vision->isVisible(row, col))
             {
-                std::shared_ptr<DisplayComponent> displayComponent = entity->getComponent<DisplayComponent>();
-
-                auto stairsComponent = entity->getComponent<StairsComponent>();
-
-                if (stairsComponent && !player->getComponent<CompassComponent>())
-                {
-                    outputColor(BOARD.at(row).at(col));
-                }
-                else
-                {
-                    outputColor(displayComponent->display_char);
-                }
+                currentFrame.push_back(vision->isExplored(row, col) ? c : ' ');
+                continue;
             }
-            else
+            Entity entity = entityManager.getEntity(row, col);
+            if (entity && !(entity.hasComponent<StairsComponent>() && !player.hasComponent<CompassComponent>()))
             {
-                outputColor(BOARD.at(row).at(col));
+                c = entity.getComponent<DisplayComponent>()->display_char;
             }
+            currentFrame.push_back(c);
         }
-        std::cout << std::endl;
     }
-    std::string output = "";
+}
 
-    output += "Race: " + player->getComponent<PlayerRaceComponent>()->race;
+void DisplaySystem::update(EntityManager &entityManager, Entity player, int floor)
+{
+    composeFrame(entityManager, player);
 
-    // Format gold to 1 decimal place
-    std::ostringstream goldStream;
-    goldStream << std::fixed << std::setprecision(1) << player->getComponent<GoldComponent>()->gold;
-    output += " Gold: " + goldStream.str();
+    frameBuffer.clear();
+    bool full = fullRedraw || terminalResized || previousFrame.size() != currentFrame.size() || previousWidth != viewWidth;
+    fullRedraw = false;
+    terminalResized = 0;
+
+    if (full)
+    {
+        // clear the screen and home the cursor
+        emit("\e[2J\e[H");
+        cursorRow = 0;
+        cursorCol = 0;
+        activeColor = nullptr;
+    }
+
+    for (int row = 0; row < viewHeight; row++)
+    {
+        for (int col = 0; col < viewWidth; col++)
+        {
+            int cell = row * viewWidth + col;
+            if (full || currentFrame[cell] != previousFrame[cell])
+            {
+                emitCell(row, col, currentFrame[cell]);
+            }
+        }
+    }
+    emit(COLOR_RESET);
+    activeColor = nullptr;
+    previousFrame.swap(currentFrame);
+    previousWidth = viewWidth;
 
-    output += " Floor: " + std::to_string(floor + 1);
+    // the status lines are short, so they are always rewritten below the map
+    emit("\e[");
+    emit(viewHeight + 1);
+    emit(";1H");
 
-    // std::string attack_output = std::to_string(player->getComponent<AttackComponent>()->attackPower);
-    // std::string defense_output = std::to_string(player->getComponent<DefenseComponent>()->defensePower);
-    int attack_output = (player->getComponent<AttackComponent>()->attackPower);
-    int defense_output = (player->getComponent<DefenseComponent>()->defensePower);
+    int attack_output = (player.getComponent<AttackComponent>()->attackPower);
+    int defense_output = (player.getComponent<DefenseComponent>()->defensePower);
 
-    auto potionEffectComponent = player->getComponent<PotionEffectComponent>();
+    auto potionEffectComponent = player.getComponent<PotionEffectComponent>();
     if (potionEffectComponent)
     {
-        // attack_output += " + " + std::to_string(potionEffectComponent->attackChange);
-        // defense_output += " + " + std::to_string(potionEffectComponent->defenseChange);
         attack_output += (potionEffectComponent->attackChange);
         defense_output += (potionEffectComponent->defenseChange);
     }
 
-    std::cout << output << std::endl;
-    std::cout << "HP: " << player->getComponent<HealthComponent>()->currentHealth << std::endl;
-    std::cout << "Atk: " << attack_output << std::endl;
-    std::cout << "Def: " << defense_output << std::endl;
+    // Format gold to 1 decimal place
+    char gold[32];
+    int goldLength = std::snprintf(gold, sizeof(gold), "%.1f", player.getComponent<GoldComponent>()->gold);
+
+    // \e[K clears what is left of the previous frame's line
+    emit("\e[KRace: ");
+    emit(traitsOf(player.getComponent<PlayerRaceComponent>()->race).name);
+    emit(" Gold: ");
+    frameBuffer.append(gold, goldLength);
+    emit(" Floor: ");
+    emit(floor + 1);
+    emit("\n\e[KHP: ");
+    emit(player.getComponent<HealthComponent>()->currentHealth);
+    emit("\n\e[KAtk: ");
+    emit(attack_output);
+    emit("\n\e[KDef: ");
+    emit(defense_output);
+    emit("\n");
 
     // process action
-    std::cout << "Action: ";
-    for (int i = 0; i < actionMessage.size(); i++) {
-        actionMessage[i][0] = toupper(actionMessage[i][0]);
-        std::cout << actionMessage[i];
-        if (i != actionMessage.size() - 1) {
-            std::cout << " ";
+    emit("\e[KAction: ");
+    for (std::size_t i = 0; i < context.actionMessage.size(); i++) {
+        context.actionMessage[i][0] = toupper(context.actionMessage[i][0]);
+        emit(context.actionMessage[i]);
+        if (i != context.actionMessage.size() - 1) {
+            emit(" ");
         }
     }
-    std::cout << "\n";
+    emit("\n");
+
+    if (showFrameStats)
+    {
+        emit("\e[KFrame: ");
+        emit(static_cast<int>(frameBuffer.size()));
+        emit(" bytes\n");
+    }
+
+    // clear the previous command and any error printed below the status lines
+    emit("\e[J");
+    frameBytes = frameBuffer.size();
+    totalBytes += frameBytes;
+    flush();
+}
+
+void DisplaySystem::invalidate()
+{
+    fullRedraw = true;
+}
+
+void DisplaySystem::setVision(const VisionSystem *visionSystem)
+{
+    vision = visionSystem;
+}
+
+void DisplaySystem::setShowFrameStats(bool show)
+{
+    showFrameStats = show;
+}
+
+std::size_t DisplaySystem::lastFrameBytes() const
+{
+    return frameBytes;
+}
+
+std::size_t DisplaySystem::totalFrameBytes() const
+{
+    return totalBytes;
 }
@@ -1,16 +1,10 @@
 #include "systems/input_system.h"
 #include <iostream>
 #include <sstream>
-#include <algorithm>
 
 using namespace std;
 
-bool InputSystem::validDirection(std::string command)
-{
-    return find(valid_directions.begin(), valid_directions.end(), command) != valid_directions.end();
-}
-
-void InputSystem::update(string &input, shared_ptr<Entity> player)
+void InputSystem::update(string &input, Entity player)
 {
     string command;
     stringstream iss(input);
@@ -18,30 +12,31 @@ void InputSystem::update(string &input, shared_ptr<Entity> player)
 
     if (command == "u")
     {
-        player->getComponent<ActionComponent>()->move = false;
-        player->getComponent<ActionComponent>()->attack = false;
-        player->getComponent<ActionComponent>()->use = true;
+        player.getComponent<ActionComponent>()->move = false;
+        player.getComponent<ActionComponent>()->attack = false;
+        player.getComponent<ActionComponent>()->use = true;
         command.clear();
         iss >> command;
     }
     else if (command == "a")
     {
-        player->getComponent<ActionComponent>()->move = false;
-        player->getComponent<ActionComponent>()->attack = true;
-        player->getComponent<ActionComponent>()->use = false;
+        player.getComponent<ActionComponent>()->move = false;
+        player.getComponent<ActionComponent>()->attack = true;
+        player.getComponent<ActionComponent>()->use = false;
         command.clear();
         iss >> command;
     }
     else
     {
-        player->getComponent<ActionComponent>()->move = true;
-        player->getComponent<ActionComponent>()->attack = false;
-        player->getComponent<ActionComponent>()->use = false;
+        player.getComponent<ActionComponent>()->move = true;
+        player.getComponent<ActionComponent>()->attack = false;
+        player.getComponent<ActionComponent>()->use = false;
     }
 
-    if (validDirection(command))
+    Direction direction = directionFromName(command);
+    if (direction != Direction::COUNT)
     {
-        player->getComponent<DirectionComponent>()->direction = command;
+        player.getComponent<DirectionComponent>()->direction = direction;
         return;
     }
     throw "Not valid command!";
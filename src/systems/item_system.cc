@@ -4,11 +4,11 @@
 #include "components/components.h"
 #include "constants/constants.h"
 
-void ItemSystem::useTreasure(EntityManager &entityManager, std::shared_ptr<Entity> player, std::shared_ptr<Entity> treasure)
+void ItemSystem::useTreasure(EntityManager &entityManager, Entity player, Entity treasure)
 {
-    std::shared_ptr<TreasureComponent> treasureComponent = treasure->getComponent<TreasureComponent>();
-    std::shared_ptr<GoldComponent> playerGoldComponent = player->getComponent<GoldComponent>();
-    std::shared_ptr<GoldMultiplierComponent> multiplier = player->getComponent<GoldMultiplierComponent>();
+    TreasureComponent *treasureComponent = treasure.getComponent<TreasureComponent>();
+    GoldComponent *playerGoldComponent = player.getComponent<GoldComponent>();
+    GoldMultiplierComponent *multiplier = player.getComponent<GoldMultiplierComponent>();
     float gold = treasureComponent->value;
 
     if (multiplier)
@@ -20,53 +20,55 @@ void ItemSystem::useTreasure(EntityManager &entityManager, std::shared_ptr<Entit
     entityManager.removeEntity(treasure);
 }
 
-void ItemSystem::useCompass(EntityManager &entityManager, std::shared_ptr<Entity> player, std::shared_ptr<Entity> compass)
+void ItemSystem::useCompass(EntityManager &entityManager, Entity player, Entity compass)
 {
-    player->addComponent(std::make_shared<CompassComponent>());
+    player.addComponent(CompassComponent());
     entityManager.removeEntity(compass);
 }
 
-void ItemSystem::useBarrierSuit(EntityManager &entityManager, std::shared_ptr<Entity> player, std::shared_ptr<Entity> barrierSuit)
+void ItemSystem::useBarrierSuit(EntityManager &entityManager, Entity player, Entity barrierSuit)
 {
     // Equip barrier suit
-    player->addComponent(std::make_shared<BarrierSuitComponent>());
+    player.addComponent(BarrierSuitComponent());
     entityManager.removeEntity(barrierSuit);
 }
 
-void ItemSystem::update(EntityManager &entityManager, std::shared_ptr<Entity> player)
+void ItemSystem::update(EntityManager &entityManager, Entity player)
 {
-    std::shared_ptr<ActionComponent> actionComponent = player->getComponent<ActionComponent>();
+    ActionComponent *actionComponent = player.getComponent<ActionComponent>();
     if (!actionComponent->move)
         return;
 
-    std::shared_ptr<PositionComponent> positionComponent = player->getComponent<PositionComponent>();
+    PositionComponent *positionComponent = player.getComponent<PositionComponent>();
 
-    std::string &direction = player->getComponent<DirectionComponent>()->direction;
+    Direction direction = player.getComponent<DirectionComponent>()->direction;
 
-    int row = positionComponent->row + DIRECTION_MAP.at(direction).first;
-    int col = positionComponent->col + DIRECTION_MAP.at(direction).second;
-    std::shared_ptr<Entity> item = entityManager.getEntity(row, col);
+    int row = positionComponent->row + DIRECTION_ROW[std::size_t(direction)];
+    int col = positionComponent->col + DIRECTION_COL[std::size_t(direction)];
+    Entity item = entityManager.getEntity(row, col);
     if (!item)
     {
         return;
     }
 
-    std::shared_ptr<ItemTypeComponent> itemTypeComponent = item->getComponent<ItemTypeComponent>();
-    if (!itemTypeComponent || !item->getComponent<CanPickupComponent>())
+    ItemTypeComponent *itemTypeComponent = item.getComponent<ItemTypeComponent>();
+    if (!itemTypeComponent || !item.hasComponent<CanPickupComponent>())
     {
         return;
     }
 
-    if (itemTypeComponent->item_type == "treasure")
+    switch (itemTypeComponent->item_type)
     {
+    case ItemKind::TREASURE:
         useTreasure(entityManager, player, item);
-    }
-    else if (itemTypeComponent->item_type == "compass")
-    {
+        break;
+    case ItemKind::COMPASS:
         useCompass(entityManager, player, item);
-    }
-    else if (itemTypeComponent->item_type == "barrier_suit")
-    {
+        break;
+    case ItemKind::BARRIER_SUIT:
         useBarrierSuit(entityManager, player, item);
+        break;
+    default:
+        break;
     }
 }
\ No newline at end of file
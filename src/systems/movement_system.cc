@@ -1,142 +1,266 @@
 #include "systems/movement_system.h"
 #include "constants/constants.h"
+#include "constants/game_data.h"
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <array>
 #include <iostream>
 #include <cmath>
-#include "globals/global.h"
+#include <cassert>
+#include "game/game_context.h"
 
-bool compare(std::shared_ptr<Entity> e0, std::shared_ptr<Entity> e1) {
-    PositionComponent a = *e0->getComponent<PositionComponent>();
-    PositionComponent b = *e1->getComponent<PositionComponent>();
+// below this many enemies an insertion sort beats the radix passes
+const std::size_t SMALL_TURN_ORDER = 64;
+// Steps within which enemies sense the player, enough to cross any room of the board. Bounds
+// the search on big maps, enemies further away wander.
+const std::uint32_t CHASE_RANGE = 79;
 
-    if (a.row != b.row) {
-        return a.row < b.row; // Sort by y first
-    }
-    return a.col < b.col; // If y is the same, sort by x
-}
+MovementSystem::MovementSystem(GameContext &context) : context{context} {}
 
-void MovementSystem::update(EntityManager& entities, std::shared_ptr<Entity> player) {
-    // set all enemy move to true
-    for (auto &e : entities.getEntities())
-    {
-        if (e->getComponent<EnemyTypeComponent>())
+void MovementSystem::update(EntityManager& entities, Entity player) {
+    // set all enemy move to true, or only the ones near the player once it has moved
+    if (!activeRadius) {
+        entities.forEach<EnemyTypeComponent, MoveableComponent>([](Entity, EnemyTypeComponent &, MoveableComponent &moveable)
         {
-            e->getComponent<MoveableComponent>()->moveable = true;
-        }
+            moveable.moveable = true;
+        });
     }
 
     // player move
-    if (player->getComponent<ActionComponent>()->move)
+    if (player.getComponent<ActionComponent>()->move)
     {
-        if (!moveEntity(entities, *player, player->getComponent<DirectionComponent>()->direction))
+        if (!moveEntity(entities, player, player.getComponent<DirectionComponent>()->direction))
         {
             throw "Cannot move there!";
         };
 
         // check for potions
-        const int pCol = player->getComponent<PositionComponent>()->col;
-        const int pRow = player->getComponent<PositionComponent>()->row;
-        for (int i = -1; i <= 1; i++) {
-            for (int j = -1; j <= 1; j++)
-            {
-                if (i == j && i == 0)
-                {
-                    continue;
-                }
-
-                std::shared_ptr<Entity> e = entities.getEntity(pRow + i, pCol + j);
-                if (!e || !e->getComponent<PotionTypeComponent>()) {
-                    continue;
-                }
-                if (std::find(seenPotions.begin(), seenPotions.end(), e->getComponent<PotionTypeComponent>()->potion_type) != seenPotions.end()) {
-                    // already seen
-                    actionMessage.push_back("PC moves " + player->getComponent<DirectionComponent>()->direction +
-                        " and sees a " + e->getComponent<PotionTypeComponent>()->potion_type + " potion.");
-                } else {
-                    actionMessage.push_back(
-                        "PC moves " + player->getComponent<DirectionComponent>()->direction +
-                        " and sees an unknown potion.");
-                }
+        const int pCol = player.getComponent<PositionComponent>()->col;
+        const int pRow = player.getComponent<PositionComponent>()->row;
+        const std::string moves = std::string("PC moves ") + nameOf(player.getComponent<DirectionComponent>()->direction);
+        for (Entity e : entities.getNeighbours(pRow, pCol)) {
+            if (!e || !e.hasComponent<PotionTypeComponent>()) {
+                continue;
+            }
+            PotionKind potionType = e.getComponent<PotionTypeComponent>()->potion_type;
+            if (context.seenPotions >> int(potionType) & 1) {
+                // already seen
+                context.actionMessage.push_back(moves + " and sees a " + traitsOf(potionType).name + " potion.");
+            } else {
+                context.actionMessage.push_back(moves + " and sees an unknown potion.");
             }
         }
-        if (actionMessage.size() == 0) {
-            actionMessage.push_back("PC moves " + player->getComponent<DirectionComponent>()->direction + ".");
+        if (context.actionMessage.size() == 0) {
+            context.actionMessage.push_back(moves + ".");
         }
     }
+    // a rejected move is not a turn, so it does not count towards what sleeping enemies catch up on
+    currentTurn++;
 
-    freezeEnemies(entities, *player);
+    if (chase) {
+        // only searches again when the player has moved or the floor has changed
+        PositionComponent *position = player.getComponent<PositionComponent>();
+        chaseField.update(entities.getMap().enemyWalkable(), position->row, position->col, CHASE_RANGE);
+    }
+    if (activeRadius) {
+        wakeActive(entities, player);
+    }
+    freezeEnemies(entities, player);
 
-    std::vector<std::shared_ptr<Entity>> enemies;
-    for (auto& e : entities.getEntities()) {
-        if (!e->getComponent<EnemyTypeComponent>() || !e->getComponent<MoveableComponent>()->moveable) {
-            continue;
-        }
-        enemies.push_back(e);
+    // position is captured once when the turn order is built, so sorting never goes back to the pools
+    const std::uint32_t width = entities.getMap().getWidth();
+    if (activeRadius) {
+        collectActive(entities, player, true);
+    } else {
+        turns.clear();
+        entities.forEach<EnemyTypeComponent, MoveableComponent, PositionComponent>(
+            [this, width](Entity e, EnemyTypeComponent &, MoveableComponent &moveable, PositionComponent &position) {
+                if (moveable.moveable) {
+                    turns.push_back(EnemyTurn{position.row * width + position.col, e.id()});
+                }
+            });
+        sortTurns();
     }
-    std::sort(enemies.begin(), enemies.end(), compare);
-    for (auto& e : enemies) {
-        moveEnemy(entities, *e);
+    for (const EnemyTurn &turn : turns) {
+        moveEnemy(entities, Entity{&entities, turn.enemy});
     }
 
-    freezeEnemies(entities, *player);
+    freezeEnemies(entities, player);
+    assert(entities.validateSpatialIndex());
 }
 
-void MovementSystem::freezeEnemies(EntityManager &entities, Entity &player)
+void MovementSystem::collectActive(EntityManager &entities, Entity player, bool moveableOnly)
 {
-    const int pCol = player.getComponent<PositionComponent>()->col;
-    const int pRow = player.getComponent<PositionComponent>()->row;
-    std::shared_ptr<Entity> e;
+    const std::uint32_t width = entities.getMap().getWidth();
+    PositionComponent *position = player.getComponent<PositionComponent>();
+    turns.clear();
+    entities.forEachIn(position->row - activeRadius, position->col - activeRadius,
+                       position->row + activeRadius, position->col + activeRadius,
+                       [this, width, moveableOnly](Entity e)
+                       {
+                           MoveableComponent *moveable = e.getComponent<MoveableComponent>();
+                           if (moveable && (moveable->moveable || !moveableOnly) && e.hasComponent<EnemyTypeComponent>())
+                           {
+                               PositionComponent *at = e.getComponent<PositionComponent>();
+                               turns.push_back(EnemyTurn{at->row * width + at->col, e.id()});
+                           }
+                       });
+}
 
-    for (int i = -1; i <= 1; i++)
+void MovementSystem::wakeActive(EntityManager &entities, Entity player)
+{
+    collectActive(entities, player, false);
+    for (const EnemyTurn &turn : turns)
     {
-        for (int j = -1; j <= 1; j++)
+        Entity{&entities, turn.enemy}.getComponent<MoveableComponent>()->moveable = true;
+    }
+    // an enemy next to the player stays there, catching up included
+    freezeEnemies(entities, player);
+
+    for (const EnemyTurn &turn : turns)
+    {
+        Entity enemy{&entities, turn.enemy};
+        MoveableComponent *moveable = enemy.getComponent<MoveableComponent>();
+        // An enemy met for the first time is where the floor put it, which is as good as anywhere a
+        // random walk would have taken it. One that was left behind makes up for the turns it slept.
+        if (moveable->moveable && moveable->lastTurn != 0 && moveable->lastTurn + 1 < currentTurn)
         {
-            e = entities.getEntity(pRow + i, pCol + j);
-            if ((i == j && i == 0) || !e || !e->getComponent<EnemyTypeComponent>())
-            { // if entity is nullptr or i == j == 0
-                continue;
+            std::uint32_t slept = std::min<std::uint32_t>(currentTurn - moveable->lastTurn - 1, activeRadius);
+            for (std::uint32_t step = 0; step < slept; step++)
+            {
+                moveEnemy(entities, enemy);
             }
-            e->getComponent<MoveableComponent>()->moveable = false;
         }
+        moveable->lastTurn = currentTurn;
     }
 }
 
-void MovementSystem::moveEnemy(EntityManager &entities, Entity &enemy)
+void MovementSystem::sortTurns()
 {
-    auto it = DIRECTION_MAP.begin();
-    std::advance(it, std::rand() % 8);
-    std::string direction = it->first;
-    while (!moveEntity(entities, enemy, direction))
+    if (turns.size() <= SMALL_TURN_ORDER)
     {
-        it = DIRECTION_MAP.begin();
-        advance(it, std::rand() % 8);
-        direction = it->first;
-    };
+        for (std::size_t i = 1; i < turns.size(); i++)
+        {
+            EnemyTurn turn = turns[i];
+            std::size_t j = i;
+            for (; j > 0 && turns[j - 1].cell > turn.cell; j--)
+            {
+                turns[j] = turns[j - 1];
+            }
+            turns[j] = turn;
+        }
+        return;
+    }
+
+    // Least significant byte first, one counting pass per byte the biggest cell needs: two on
+    // the board, three on a 1000x1000 map. No two enemies share a cell, so any order is unique.
+    std::uint32_t lastCell = 0;
+    for (const EnemyTurn &turn : turns)
+    {
+        lastCell = std::max(lastCell, turn.cell);
+    }
+    sortScratch.resize(turns.size());
+    for (int shift = 0; shift < 32 && lastCell >> shift; shift += 8)
+    {
+        std::array<std::uint32_t, 257> starts{};
+        for (const EnemyTurn &turn : turns)
+        {
+            starts[(turn.cell >> shift & 0xff) + 1]++;
+        }
+        for (std::size_t digit = 1; digit < starts.size(); digit++)
+        {
+            starts[digit] += starts[digit - 1];
+        }
+        for (const EnemyTurn &turn : turns)
+        {
+            sortScratch[starts[turn.cell >> shift & 0xff]++] = turn;
+        }
+        turns.swap(sortScratch);
+    }
 }
 
-bool MovementSystem::moveEntity(EntityManager &entities, Entity &e, std::string &direction)
+void MovementSystem::freezeEnemies(EntityManager &entities, Entity player)
 {
-    // check map and entities
-    int newRow = e.getComponent<PositionComponent>()->row + DIRECTION_MAP.at(direction).first;
-    int newCol = e.getComponent<PositionComponent>()->col + DIRECTION_MAP.at(direction).second;
-    if (entities.getEntity(newRow, newCol) || BOARD[newRow][newCol] == '|' || BOARD[newRow][newCol] == '-' || BOARD[newRow][newCol] == ' ')
+    const int pCol = player.getComponent<PositionComponent>()->col;
+    const int pRow = player.getComponent<PositionComponent>()->row;
+
+    for (Entity e : entities.getNeighbours(pRow, pCol))
     {
-        return false;
+        if (!e || !e.hasComponent<EnemyTypeComponent>())
+        {
+            continue;
+        }
+        e.getComponent<MoveableComponent>()->moveable = false;
+    }
+}
+
+void MovementSystem::moveEnemy(EntityManager &entities, Entity enemy)
+{
+    // a boxed in enemy stays where it is
+    std::uint32_t moves = legalMoves(entities, enemy);
+    if (!moves)
+    {
+        return;
     }
 
-    // enemy checks
-    if (e.getComponent<EnemyTypeComponent>() && BOARD[newRow][newCol] == '+')
+    if (chase && chases(enemy))
+    {
+        // one of the steps closest to the player; walled off or already as close as it gets, it wanders
+        PositionComponent *position = enemy.getComponent<PositionComponent>();
+        std::uint32_t closer = chaseField.closerNeighbours(position->row, position->col, moves);
+        if (closer)
+        {
+            moves = closer;
+        }
+    }
+
+    // one draw, uniform over the moves left: drop the lowest set bits until the pick is lowest
+    for (int pick = context.movementRng.below(__builtin_popcount(moves)); pick > 0; pick--)
+    {
+        moves &= moves - 1;
+    }
+    moveEntity(entities, enemy, Direction(__builtin_ctz(moves)));
+}
+
+bool MovementSystem::chases(Entity enemy) const
+{
+    // merchants keep to themselves until one of them is attacked
+    return enemy.getComponent<EnemyTypeComponent>()->enemy_type != EnemyKind::MERCHANT || context.merchantHostile;
+}
+
+void MovementSystem::setChase(bool enabled)
+{
+    chase = enabled;
+}
+
+void MovementSystem::setActiveRadius(int radius)
+{
+    activeRadius = radius;
+}
+
+std::uint8_t MovementSystem::legalMoves(EntityManager &entities, Entity e)
+{
+    PositionComponent *position = e.getComponent<PositionComponent>();
+    const FloorMap &map = entities.getMap();
+    const Bitboard &walkable = e.hasComponent<EnemyTypeComponent>() ? map.enemyWalkable() : map.playerWalkable();
+    return walkable.neighbours(position->row, position->col) & ~entities.getOccupancy().neighbours(position->row, position->col);
+}
+
+bool MovementSystem::moveEntity(EntityManager &entities, Entity e, Direction direction)
+{
+    if (!(legalMoves(entities, e) >> int(direction) & 1))
     {
         return false;
     }
+    int newRow = e.getComponent<PositionComponent>()->row + DIRECTION_ROW[std::size_t(direction)];
+    int newCol = e.getComponent<PositionComponent>()->col + DIRECTION_COL[std::size_t(direction)];
 
     // dragon movement
-    if (e.getComponent<EnemyTypeComponent>() && e.getComponent<EnemyTypeComponent>()->enemy_type == "dragon")
+    if (e.hasComponent<EnemyTypeComponent>() && e.getComponent<EnemyTypeComponent>()->enemy_type == EnemyKind::DRAGON)
     {
         return true;
-        // std::shared_ptr<GuardingPositionComponent> guardCoords = e.getComponent<GuardingPositionComponent>();
+        // GuardingPositionComponent *guardCoords = e.getComponent<GuardingPositionComponent>();
         // if (!guardCoords)
         // {
         //     throw std::runtime_error("Dragon does not have guarding position component");
@@ -147,7 +271,6 @@ bool MovementSystem::moveEntity(EntityManager &entities, Entity &e, std::string
         //     return false;
         // }
     }
-    e.getComponent<PositionComponent>()->col = newCol;
-    e.getComponent<PositionComponent>()->row = newRow;
+    entities.setPosition(e, newRow, newCol);
     return true;
 }
\ No newline at end of file
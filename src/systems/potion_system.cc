@@ -2,92 +2,65 @@
 #include "entities/entity_manager.h"
 #include "entities/entity.h"
 #include "components/components.h"
-#include "globals/global.h"
+#include "game/game_context.h"
 #include "constants/constants.h"
+#include "constants/game_data.h"
 
-void PotionSystem::usePotion(EntityManager &entityManager, std::shared_ptr<Entity> player, std::shared_ptr<Entity> potion)
+PotionSystem::PotionSystem(GameContext &context) : context{context} {}
+
+void PotionSystem::usePotion(EntityManager &entityManager, Entity player, Entity potion)
 {
-    std::string potionType = potion->getComponent<PotionTypeComponent>()->potion_type;
-    auto healthComponent = player->getComponent<HealthComponent>();
-    auto attackComponent = player->getComponent<AttackComponent>();
-    auto defenseComponent = player->getComponent<DefenseComponent>();
-    auto potionEffectComponent = player->getComponent<PotionEffectComponent>();
-    seenPotions.push_back(potionType);
-    actionMessage.push_back("PC uses " + potionType + ".");
+    PotionKind potionType = potion.getComponent<PotionTypeComponent>()->potion_type;
+    auto healthComponent = player.getComponent<HealthComponent>();
+    auto attackComponent = player.getComponent<AttackComponent>();
+    auto defenseComponent = player.getComponent<DefenseComponent>();
+    auto potionEffectComponent = player.getComponent<PotionEffectComponent>();
+    context.seenPotions |= 1 << int(potionType);
+    context.actionMessage.push_back(std::string("PC uses ") + traitsOf(potionType).name + ".");
 
-    if (player->getComponent<AllPositiveComponent>()) {
-        if (potionType == "PH")
-        {
-            potionType = "RH";
-        }
-        else if (potionType == "WA")
-        {
-            potionType = "BA";
-        }
-        else if (potionType == "WD")
-        {
-            potionType = "BD";
-        }
+    if (player.hasComponent<AllPositiveComponent>()) {
+        potionType = traitsOf(potionType).positive;
     }
 
-    if (potionType == "RH")
-    {
-        healthComponent->currentHealth += 10;
-        if (healthComponent->currentHealth > healthComponent->maxHealth)
-        {
-            healthComponent->currentHealth = healthComponent->maxHealth;
-        }
-    }
-    else if (potionType == "BA")
-    {
-        potionEffectComponent->attackChange += 5;
-    }
-    else if (potionType == "BD")
-    {
-        potionEffectComponent->defenseChange += 5;
-    }
-    else if (potionType == "PH")
+    // every potion is a row of the table, nothing to dispatch on
+    const PotionTraits &effect = traitsOf(potionType);
+    healthComponent->currentHealth += effect.health;
+    if (effect.health > 0 && healthComponent->currentHealth > healthComponent->maxHealth)
     {
-        healthComponent->currentHealth -= 10;
+        healthComponent->currentHealth = healthComponent->maxHealth;
     }
-    else if (potionType == "WA")
+    potionEffectComponent->attackChange += effect.attack;
+    if (effect.attack < 0 && potionEffectComponent->attackChange + attackComponent->attackPower < 0)
     {
-        potionEffectComponent->attackChange -= 5;
-        if (potionEffectComponent->attackChange  + attackComponent->attackPower < 0)
-        {
-            potionEffectComponent->attackChange = attackComponent->attackPower*-1;
-        }
+        potionEffectComponent->attackChange = attackComponent->attackPower*-1;
     }
-    else if (potionType == "WD")
+    potionEffectComponent->defenseChange += effect.defense;
+    if (effect.defense < 0 && potionEffectComponent->defenseChange + defenseComponent->defensePower < 0)
     {
-        potionEffectComponent->defenseChange -= 5;
-        if (potionEffectComponent->defenseChange  + defenseComponent->defensePower < 0)
-        {
-            potionEffectComponent->defenseChange = defenseComponent->defensePower*-1;
-        }
+        potionEffectComponent->defenseChange = defenseComponent->defensePower*-1;
     }
     entityManager.removeEntity(potion);
 }
 
-void PotionSystem::update(EntityManager &entityManager, std::shared_ptr<Entity> player)
+void PotionSystem::update(EntityManager &entityManager, Entity player)
 {
-    std::shared_ptr<ActionComponent> actionComponent = player->getComponent<ActionComponent>();
+    ActionComponent *actionComponent = player.getComponent<ActionComponent>();
     if (!actionComponent->use)
         return;
 
-    std::shared_ptr<PositionComponent> positionComponent = player->getComponent<PositionComponent>();
-    std::string &direction = player->getComponent<DirectionComponent>()->direction;
+    PositionComponent *positionComponent = player.getComponent<PositionComponent>();
+    Direction direction = player.getComponent<DirectionComponent>()->direction;
 
-    int row = positionComponent->row + DIRECTION_MAP.at(direction).first;
-    int col = positionComponent->col + DIRECTION_MAP.at(direction).second;
-    std::shared_ptr<Entity> potion = entityManager.getEntity(row, col);
+    int row = positionComponent->row + DIRECTION_ROW[std::size_t(direction)];
+    int col = positionComponent->col + DIRECTION_COL[std::size_t(direction)];
+    Entity potion = entityManager.getEntity(row, col);
 
     if (!potion)
     {
         return;
     }
 
-    if (!potion->getComponent<PotionTypeComponent>())
+    if (!potion.hasComponent<PotionTypeComponent>())
     {
         return;
     }
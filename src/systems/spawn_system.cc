@@ -1,250 +1,305 @@
+#include <chrono>
 #include "systems/spawn_system.h"
 #include "entities/entity_manager.h"
 #include "entities/entity.h"
 #include "constants/constants.h"
+#include "game/game_context.h"
+#include "constants/game_data.h"
+#include "map/floor_file.h"
+#include "map/floor_map.h"
+#include "map/rooms.h"
 
-std::shared_ptr<Entity> SpawnSystem::spawnDragonAround(EntityManager &entityManager, int row, int col, bool spawnWithCompass)
+Entity SpawnSystem::spawnDragonAround(EntityManager &entityManager, Rng &rng, int row, int col, bool spawnWithCompass)
 {
-    while (true)
+    // the hoard can end up walled in by other entities, then it is left unguarded
+    std::uint8_t free = entityManager.getMap().roomFloor().neighbours(row, col) & ~entityManager.getOccupancy().neighbours(row, col);
+    if (!free)
     {
-        int i = random() % 3 - 1;
-        int j = random() % 3 - 1;
-        std::pair<int, int> dragonPos = std::make_pair(row + i, col + j);
-        if (i == 0 && j == 0)
-        {
-            continue;
-        }
+        return Entity();
+    }
 
-        if (entityManager.getEntity(dragonPos.first, dragonPos.second))
-        {
-            continue;
-        }
-        if (BOARD[dragonPos.first][dragonPos.second] != '.') // if dragonPos is not a floor tile
-        {
-            continue;
-        }
-        std::shared_ptr<Entity> dragon = spawnEnemy(entityManager, dragonPos.first, dragonPos.second, "dragon", spawnWithCompass);
-        dragon->addComponent(std::make_shared<GuardingPositionComponent>(row, col));
-        return dragon;
+    // the pick-th free neighbour, so every free cell is equally likely and nothing is retried
+    std::uint32_t remaining = free;
+    for (std::uint32_t pick = rng.below(__builtin_popcount(free)); pick > 0; pick--)
+    {
+        remaining &= remaining - 1;
     }
+    int bit = __builtin_ctz(remaining);
+    Entity dragon = spawnEnemy(entityManager, row + DIRECTION_ROW[bit], col + DIRECTION_COL[bit], EnemyKind::DRAGON, spawnWithCompass);
+    dragon.addComponent(GuardingPositionComponent(row, col));
+    return dragon;
 }
 
-void SpawnSystem::moveToNextFloor(std::vector<EntityManager> &entityManagers, int &floor, std::shared_ptr<Entity> &prevPlayer)
+void SpawnSystem::moveToNextFloor(EntityManager &entityManager, int &floor, Entity &prevPlayer)
 {
     // Increase floor and move player attributes to next floor
     floor++;
 
-    if (floor >= NUM_FLOORS) // Game won
+    if (floor >= floorCount) // Game won
     {
         return;
     }
 
-    EntityManager &currEntityManager = entityManagers.at(floor);
-    std::shared_ptr<Entity> currPlayer;
-
-    for (auto &entity : currEntityManager.getEntities())
+    auto start = std::chrono::steady_clock::now();
+    bool ready = waitForPrefetch();
+    bool staged = stagedFloor == floor;
+    if (!staged)
     {
-        if (entity->getComponent<PlayerRaceComponent>())
-        {
-            currPlayer = entity;
-            break;
-        }
+        buildFloor(*staging, floor);
+    }
+    stagedFloor = -1;
+    if (!ready || !staged)
+    {
+        transitions.waited += staged;
+        transitions.built += !staged;
+        double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        transitions.waitMicroseconds += microseconds;
+        transitions.maxWaitMicroseconds = std::max(transitions.maxWaitMicroseconds, microseconds);
     }
 
+    start = std::chrono::steady_clock::now();
+    Entity currPlayer;
+    staging->forEach<PlayerRaceComponent>([&currPlayer](Entity entity, PlayerRaceComponent &)
+                                          { currPlayer = entity; });
+
     //  Move player attributes to next floor
-    currPlayer->getComponent<HealthComponent>()->currentHealth = prevPlayer->getComponent<HealthComponent>()->currentHealth;
-    currPlayer->getComponent<GoldComponent>()->gold = prevPlayer->getComponent<GoldComponent>()->gold;
-    currPlayer->getComponent<ActionComponent>()->move = false;
-    if (prevPlayer->getComponent<BarrierSuitComponent>())
+    currPlayer.getComponent<HealthComponent>()->currentHealth = prevPlayer.getComponent<HealthComponent>()->currentHealth;
+    currPlayer.getComponent<GoldComponent>()->gold = prevPlayer.getComponent<GoldComponent>()->gold;
+    currPlayer.getComponent<ActionComponent>()->move = false;
+    if (prevPlayer.hasComponent<BarrierSuitComponent>())
     {
-        currPlayer->addComponent(std::make_shared<BarrierSuitComponent>());
+        currPlayer.addComponent(BarrierSuitComponent());
     }
 
-    prevPlayer = currPlayer;
+    // hand the storage over instead of copying it, the floor left behind is never visited again
+    entityManager.swap(*staging);
+    prevPlayer = Entity{&entityManager, currPlayer.id()};
+
+    double microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    transitions.count++;
+    transitions.totalMicroseconds += microseconds;
+    transitions.maxMicroseconds = std::max(transitions.maxMicroseconds, microseconds);
+
+    startPrefetch(floor + 1);
 }
 
-void SpawnSystem::readFloors(std::vector<EntityManager> &entityManagers, const std::string &filePath, const std::string &race)
+SpawnSystem::SpawnSystem() : placement{boardMap()->rooms(), FLOOR_HEIGHT, FLOOR_WIDTH}, blueprints{new EntityManager()}, staging{new EntityManager()}
 {
-    std::ifstream file(filePath);
-    std::string line;
+    buildBlueprints();
+}
 
-    for (int floor = 0; floor < NUM_FLOORS; floor++)
+SpawnSystem::~SpawnSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    if (worker.joinable())
     {
-        EntityManager &entityManager = entityManagers.at(floor);
+        worker.join();
+    }
+}
 
-        bool compass_spawned = false;
-        for (int row = 0; row < FLOOR_HEIGHT; row++)
-        {
-            std::getline(file, line);
-            for (int col = 0; col < 79; col++)
-            {
-                char tile = line[col];
-                if (tile == '@')
-                {
-                    spawnPlayer(entityManager, row, col, race);
-                }
-                else if (tile == 'V')
-                {
-
-                    spawnEnemy(entityManager, row, col, "vampire", !compass_spawned);
-                    compass_spawned = true;
-                }
-                else if (tile == 'W')
-                {
-
-                    spawnEnemy(entityManager, row, col, "werewolf", !compass_spawned);
-                    compass_spawned = true;
-                }
-                else if (tile == 'N')
-                {
-                    spawnEnemy(entityManager, row, col, "goblin", !compass_spawned);
-                    compass_spawned = true;
-                }
-                else if (tile == 'M')
-                {
-                    spawnEnemy(entityManager, row, col, "merchant", !compass_spawned);
-                    compass_spawned = true;
-                }
-                else if (tile == 'D')
-                {
-                    std::shared_ptr<Entity> dragon = spawnEnemy(entityManager, row, col, "dragon", false);
-                    // TODO: find an actual dragon hoard/barrier suit to guard
-                    dragon->addComponent(std::make_shared<GuardingPositionComponent>(row - 1, col));
-                }
-                else if (tile == 'X')
-                {
-                    spawnEnemy(entityManager, row, col, "phoenix", !compass_spawned);
-                    compass_spawned = true;
-                }
-                else if (tile == 'T')
-                {
-                    spawnEnemy(entityManager, row, col, "troll", !compass_spawned);
-                    compass_spawned = true;
-                }
-                else if (tile == '0')
-                {
-                    spawnPotion(entityManager, row, col, "RH");
-                }
-                else if (tile == '1')
-                {
-                    spawnPotion(entityManager, row, col, "BA");
-                }
-                else if (tile == '2')
-                {
-                    spawnPotion(entityManager, row, col, "BD");
-                }
-                else if (tile == '3')
-                {
-                    spawnPotion(entityManager, row, col, "PH");
-                }
-                else if (tile == '4')
-                {
-                    spawnPotion(entityManager, row, col, "WA");
-                }
-                else if (tile == '5')
-                {
-                    spawnPotion(entityManager, row, col, "WD");
-                }
-                else if (tile == '6')
-                {
-                    spawnTreasure(entityManager, row, col, 1);
-                }
-                else if (tile == '7')
-                {
-                    spawnTreasure(entityManager, row, col, 2);
-                }
-                else if (tile == '8')
-                {
-                    spawnTreasure(entityManager, row, col, 4);
-                }
-                else if (tile == '9')
-                {
-                    spawnTreasure(entityManager, row, col, 6);
-                }
-                else if (tile == 'B')
-                {
-                    spawnItem(entityManager, row, col, "barrier_suit");
-                }
-                else if (tile == 'C')
-                {
-                    spawnItem(entityManager, row, col, "compass");
-                }
-                else if (tile == '\\')
-                {
-                    spawnItem(entityManager, row, col, "stairs");
-                }
-            }
-        }
+void SpawnSystem::startGame(EntityManager &entityManager, int newSeed, Race newRace, std::shared_ptr<const FloorFile> newFloorFile, int newFloorCount, int newBarrierSuitFloor)
+{
+    // the worker may still be building a floor of the previous game
+    waitForPrefetch();
+    stagedFloor = -1;
+
+    seed = newSeed;
+    race = newRace;
+    floorFile = std::move(newFloorFile);
+    floorCount = newFloorCount;
+    barrierSuitFloor = newBarrierSuitFloor;
+    cache.use(seed, race, floorCount);
+    buildFloor(entityManager, 0);
+    startPrefetch(1);
+}
+
+void SpawnSystem::buildFloor(EntityManager &entityManager, int floor)
+{
+    const FloorPage *cached = cache.find(floor);
+    if (cached)
+    {
+        entityManager.pageIn(*cached);
+        return;
+    }
+
+    if (floorFile)
+    {
+        readFloor(entityManager, floor);
+    }
+    else
+    {
+        newFloor(entityManager, seed * (floor + 1), floor == barrierSuitFloor, race);
     }
+    cache.store(floor, entityManager);
 }
 
-void SpawnSystem::newFloor(EntityManager &entityManager, const int seed, bool spawnBarrierSuit, const std::string &race)
+void SpawnSystem::startPrefetch(int floor)
 {
-    // Seed random number generator
-    std::srand(seed);
+    if (!prefetch || floor >= floorCount)
+    {
+        return;
+    }
+    // The worker owns staging and the cache until waitForPrefetch returns. Everything else it
+    // reads (seed, race, file, floor count, barrier suit floor) only changes in startGame, which waits first.
+    stagedFloor = floor;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        requested = floor;
+    }
+    if (!worker.joinable())
+    {
+        worker = std::thread(&SpawnSystem::work, this);
+    }
+    wake.notify_one();
+}
 
-    // Remove all entities from the previous floor except the player
-    std::shared_ptr<Entity> player;
-    for (auto &entity : entityManager.getEntities())
+void SpawnSystem::work()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
     {
-        if (entity->getComponent<PlayerRaceComponent>())
+        wake.wait(lock, [this]()
+                  { return requested >= 0 || stopping; });
+        if (stopping)
         {
-            player = entity;
-            continue;
+            return;
         }
-        entityManager.removeEntity(entity);
+        int floor = requested;
+        requested = -1;
+        building = true;
+        lock.unlock();
+        buildFloor(*staging, floor);
+        lock.lock();
+        building = false;
+        finished.notify_one();
     }
+}
 
-    // Spawn player in random room
-    int playerRoom = std::rand() % 5;
-    std::pair<int, int> playerPos = ROOMS[playerRoom][std::rand() % ROOMS[playerRoom].size()];
+bool SpawnSystem::waitForPrefetch()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    bool ready = requested < 0 && !building;
+    finished.wait(lock, [this]()
+                  { return requested < 0 && !building; });
+    return ready;
+}
 
-    if (player)
+void SpawnSystem::setPrefetch(bool enabled)
+{
+    prefetch = enabled;
+}
+
+const TransitionStats &SpawnSystem::getTransitionStats() const
+{
+    return transitions;
+}
+
+void SpawnSystem::readFloor(EntityManager &entityManager, int floor)
+{
+    entityManager.setMap(floorFile->getMap(floor));
+    bool compassSpawned = false;
+    for (const FloorSpawn *spawn = floorFile->begin(floor); spawn != floorFile->end(floor); spawn++)
     {
-        player->getComponent<PositionComponent>()->row = playerPos.first;
-        player->getComponent<PositionComponent>()->col = playerPos.second;
+        switch (spawn->kind)
+        {
+        case FloorSpawn::PLAYER:
+            spawnPlayer(entityManager, spawn->row, spawn->col, race);
+            break;
+        case FloorSpawn::ENEMY:
+            if (EnemyKind(spawn->type) == EnemyKind::DRAGON)
+            {
+                Entity dragon = spawnEnemy(entityManager, spawn->row, spawn->col, EnemyKind::DRAGON, false);
+                dragon.addComponent(GuardingPositionComponent(spawn->guardRow, spawn->guardCol));
+            }
+            else
+            {
+                // the first enemy that is not a dragon carries the compass
+                spawnEnemy(entityManager, spawn->row, spawn->col, EnemyKind(spawn->type), !compassSpawned);
+                compassSpawned = true;
+            }
+            break;
+        case FloorSpawn::POTION:
+            spawnPotion(entityManager, spawn->row, spawn->col, PotionKind(spawn->type));
+            break;
+        case FloorSpawn::TREASURE:
+        case FloorSpawn::HOARD:
+            spawnTreasure(entityManager, spawn->row, spawn->col, spawn->type, spawn->kind == FloorSpawn::HOARD);
+            break;
+        case FloorSpawn::ITEM:
+            spawnItem(entityManager, spawn->row, spawn->col, ItemKind(spawn->type));
+            break;
+        }
     }
-    else
+}
+
+namespace
+{
+    // the entry a roll below the table's total weight lands on
+    template <typename Roll>
+    const Roll &pickWeighted(const std::vector<Roll> &table, int roll)
     {
-        spawnPlayer(entityManager, playerPos.first, playerPos.second, race);
+        for (const Roll &entry : table)
+        {
+            if (roll < entry.weight)
+            {
+                return entry;
+            }
+            roll -= entry.weight;
+        }
+        return table.back();
     }
+}
 
-    // Spawn stairs in random room
-    int stairsRoom = std::rand() % 5;
-    while (stairsRoom == playerRoom)
+void SpawnSystem::newFloor(EntityManager &entityManager, const int seed, bool spawnBarrierSuit, Race race)
+{
+    // every floor draws from its own generator, independent of the game in progress
+    Rng rng(seed, FLOOR_STREAM);
+
+    // Recycle the previous floor's storage, the player is respawned from its race
+    entityManager.setMap(boardMap());
+
+    // a dragon is placed next to its hoard rather than taken from the free cells
+    auto claimDragon = [this](Entity dragon)
     {
-        stairsRoom = std::rand() % 5;
-    }
-    std::pair<int, int> stairsPos = ROOMS[stairsRoom][std::rand() % ROOMS[stairsRoom].size()];
-    spawnItem(entityManager, stairsPos.first, stairsPos.second, "stairs");
+        if (dragon)
+        {
+            PositionComponent *position = dragon.getComponent<PositionComponent>();
+            placement.claim(position->row, position->col);
+        }
+    };
+
+    // every spawn takes its cell from here, so nothing ever lands on top of something else
+    placement.reset();
+
+    // Spawn player in random room
+    std::pair<int, int> playerPos = placement.take(rng);
+    spawnPlayer(entityManager, playerPos.first, playerPos.second, race);
+
+    // Spawn stairs in random room
+    std::pair<int, int> stairsPos = placement.take(rng, placement.roomAt(playerPos.first, playerPos.second));
+    spawnItem(entityManager, stairsPos.first, stairsPos.second, ItemKind::STAIRS);
 
     // Spawn 10 potions
     int potionsToSpawn = 10;
-    std::vector<std::string> potionTypes = {"RH", "BA", "BD", "PH", "WA", "WD"};
     while (potionsToSpawn > 0)
     {
-        std::string potionType = potionTypes[std::rand() % 6];
-        int potionRoom = std::rand() % 5;
-        std::pair<int, int> potionPos = ROOMS[potionRoom][std::rand() % ROOMS[potionRoom].size()];
-
-        while (entityManager.getEntity(potionPos.first, potionPos.second)) // No collision
-        {
-            potionRoom = std::rand() % 5;
-            potionPos = ROOMS[potionRoom][std::rand() % ROOMS[potionRoom].size()];
-        }
-
+        PotionKind potionType = PotionKind(rng.below(int(PotionKind::COUNT)));
+        std::pair<int, int> potionPos = placement.take(rng);
         spawnPotion(entityManager, potionPos.first, potionPos.second, potionType);
         potionsToSpawn--;
     }
 
     int enemiesToSpawn = 20;                      // if a dragon is spawned, decrement
-    int enemyWithCompassIndex = std::rand() % 20; // Random index of enemy with compass
+    int enemyWithCompassIndex = rng.below(20); // Random index of enemy with compass
     if (spawnBarrierSuit)
     {
-        int barrierSuitRoom = std::rand() % 5;
-        std::pair<int, int> barrierSuitPos = ROOMS[barrierSuitRoom][std::rand() % ROOMS[barrierSuitRoom].size()];
-        spawnItem(entityManager, barrierSuitPos.first, barrierSuitPos.second, "barrier_suit");
-        spawnDragonAround(entityManager, barrierSuitPos.first, barrierSuitPos.second, enemyWithCompassIndex == enemiesToSpawn);
+        std::pair<int, int> barrierSuitPos = placement.take(rng);
+        spawnItem(entityManager, barrierSuitPos.first, barrierSuitPos.second, ItemKind::BARRIER_SUIT);
+        claimDragon(spawnDragonAround(entityManager, rng, barrierSuitPos.first, barrierSuitPos.second, enemyWithCompassIndex == enemiesToSpawn));
         enemiesToSpawn--;
     }
 
@@ -252,36 +307,14 @@ void SpawnSystem::newFloor(EntityManager &entityManager, const int seed, bool sp
     int treasureToSpawn = 10;
     while (treasureToSpawn > 0)
     {
-        int treasureRoom = std::rand() % 5;
-        std::vector<std::pair<int, int>> treasureRoomCoords = ROOMS[treasureRoom];
-        std::pair<int, int> treasurePos = treasureRoomCoords[std::rand() % treasureRoomCoords.size()];
-
-        while (entityManager.getEntity(treasurePos.first, treasurePos.second)) // No collision
-        {
-            treasureRoom = std::rand() % 5;
-            treasurePos = treasureRoomCoords[std::rand() % treasureRoomCoords.size()];
-        }
+        std::pair<int, int> treasurePos = placement.take(rng);
 
         // Determine type of treasure to spawn
-        int treasureTypeRoll = std::rand() % 8; // Random number between 0 and 7
-        int treasureValue;
-        if (treasureTypeRoll < 5) // 5/8 chance
-        {
-            treasureValue = 1;
-        }
-        else if (treasureTypeRoll == 5) // 1/8 chance
-        {
-            treasureValue = 6;
-        }
-        else // 2/8 chance (1/4)
-        {
-            treasureValue = 2;
-        }
-
-        spawnTreasure(entityManager, treasurePos.first, treasurePos.second, treasureValue);
-        if (treasureValue == 6) // Spawn dragon
+        const TreasureRoll &treasure = pickWeighted(gameData().treasures, rng.below(gameData().treasureWeight));
+        spawnTreasure(entityManager, treasurePos.first, treasurePos.second, treasure.value, treasure.hoard);
+        if (treasure.hoard) // Spawn dragon
         {
-            spawnDragonAround(entityManager, treasurePos.first, treasurePos.second, enemyWithCompassIndex == enemiesToSpawn);
+            claimDragon(spawnDragonAround(entityManager, rng, treasurePos.first, treasurePos.second, enemyWithCompassIndex == enemiesToSpawn));
             enemiesToSpawn--;
         };
         treasureToSpawn--;
@@ -290,41 +323,12 @@ void SpawnSystem::newFloor(EntityManager &entityManager, const int seed, bool sp
     // Spawn 20 enemies
     while (enemiesToSpawn > 0)
     {
-        int enemyRoom = std::rand() % 5;
-        std::pair<int, int> enemyPos = ROOMS[enemyRoom][std::rand() % ROOMS[enemyRoom].size()];
+        std::pair<int, int> enemyPos = placement.take(rng);
 
-        while (entityManager.getEntity(enemyPos.first, enemyPos.second)) // No collision
-        {
-            enemyRoom = std::rand() % 5;
-            enemyPos = ROOMS[enemyRoom][std::rand() % ROOMS[enemyRoom].size()];
-        }
-
-        int enemyTypeRoll = std::rand() % 18;
-        std::string enemyType;
-        if (enemyTypeRoll < 4) // 4/18 = 2/9 chance
-        {
-            enemyType = "werewolf";
-        }
-        else if (enemyTypeRoll < 7) // 3/18 chance
-        {
-            enemyType = "vampire";
-        }
-        else if (enemyTypeRoll < 12) // 5/18 chance
-        {
-            enemyType = "goblin";
-        }
-        else if (enemyTypeRoll < 14) // 1/9 chance
-        {
-            enemyType = "troll";
-        }
-        else if (enemyTypeRoll < 16) // 1/9 chance
-        {
-            enemyType = "phoenix";
-        }
-        else if (enemyTypeRoll < 18) // 1/9 chance
+        EnemyKind enemyType = pickWeighted(gameData().enemySpawns, rng.below(gameData().enemySpawnWeight)).kind;
+        if (enemyType == EnemyKind::MERCHANT)
         {
             enemyWithCompassIndex--; // Dont spawn merchant with compass, don't want two drops
-            enemyType = "merchant";
         }
 
         spawnEnemy(entityManager, enemyPos.first, enemyPos.second, enemyType, enemiesToSpawn == enemyWithCompassIndex);
@@ -332,205 +336,158 @@ void SpawnSystem::newFloor(EntityManager &entityManager, const int seed, bool sp
     }
 }
 
-std::shared_ptr<Entity> SpawnSystem::spawnPlayer(EntityManager &entityManager, int x, int y, const std::string &race)
+void SpawnSystem::buildBlueprints()
 {
-    auto player = entityManager.createEntity();
-
-    if (race == "human")
-    {
-        player->addComponent(std::make_shared<HealthComponent>(140));
-        player->addComponent(std::make_shared<AttackComponent>(20));
-        player->addComponent(std::make_shared<DefenseComponent>(20));
-    }
-    else if (race == "dwarf")
-    {
-        player->addComponent(std::make_shared<HealthComponent>(100));
-        player->addComponent(std::make_shared<AttackComponent>(20));
-        player->addComponent(std::make_shared<DefenseComponent>(30));
-        player->addComponent(std::make_shared<GoldMultiplierComponent>(2));
+    for (std::size_t race = 0; race < std::size_t(Race::COUNT); race++)
+    {
+        const RaceTraits &traits = traitsOf(Race(race));
+        Entity player = blueprints->createEntity();
+        player.addComponent(HealthComponent(traits.health));
+        player.addComponent(AttackComponent(traits.attack));
+        player.addComponent(DefenseComponent(traits.defense));
+        if (traits.goldMultiplier != 1)
+        {
+            player.addComponent(GoldMultiplierComponent(traits.goldMultiplier));
+        }
+        if (traits.allPositive)
+        {
+            player.addComponent(AllPositiveComponent());
+        }
+        player.addComponent(DisplayComponent('@'));
+        player.addComponent(PotionEffectComponent(0, 0));
+        player.addComponent(PlayerRaceComponent(Race(race)));
+        player.addComponent(GoldComponent(0));
+        player.addComponent(MoveableComponent(true));
+        player.addComponent(ActionComponent());
+        player.addComponent(DirectionComponent());
+        raceBlueprints[race] = player.id();
+    }
+
+    for (std::size_t kind = 0; kind < std::size_t(EnemyKind::COUNT); kind++)
+    {
+        const EnemyTraits &traits = traitsOf(EnemyKind(kind));
+        Entity enemy = blueprints->createEntity();
+        enemy.addComponent(DisplayComponent(traits.display));
+        enemy.addComponent(HealthComponent(traits.health));
+        enemy.addComponent(AttackComponent(traits.attack));
+        enemy.addComponent(DefenseComponent(traits.defense));
+        enemy.addComponent(GoldComponent(traits.gold));
+        if (traits.hostile)
+        {
+            enemy.addComponent(HostileComponent());
+        }
+        enemy.addComponent(MoveableComponent(true));
+        enemy.addComponent(EnemyTypeComponent(EnemyKind(kind)));
+        enemyBlueprints[kind] = enemy.id();
     }
-    else if (race == "elf")
+
+    for (std::size_t kind = 0; kind < std::size_t(PotionKind::COUNT); kind++)
     {
-        player->addComponent(std::make_shared<HealthComponent>(140));
-        player->addComponent(std::make_shared<AttackComponent>(30));
-        player->addComponent(std::make_shared<DefenseComponent>(10));
-        player->addComponent(std::make_shared<AllPositiveComponent>());
+        Entity potion = blueprints->createEntity();
+        potion.addComponent(DisplayComponent('P'));
+        potion.addComponent(PotionTypeComponent(PotionKind(kind)));
+        potion.addComponent(CanPickupComponent());
+        potionBlueprints[kind] = potion.id();
     }
-    else if (race == "orc")
+
+    for (std::size_t kind = 0; kind < std::size_t(ItemKind::COUNT); kind++)
     {
-        player->addComponent(std::make_shared<HealthComponent>(180));
-        player->addComponent(std::make_shared<AttackComponent>(30));
-        player->addComponent(std::make_shared<DefenseComponent>(25));
-        player->addComponent(std::make_shared<GoldMultiplierComponent>(0.5));
+        Entity item = blueprints->createEntity();
+        item.addComponent(ItemTypeComponent(ItemKind(kind)));
+        item.addComponent(DisplayComponent(traitsOf(ItemKind(kind)).display));
+        switch (ItemKind(kind))
+        {
+        case ItemKind::TREASURE:
+            item.addComponent(TreasureComponent(0));
+            item.addComponent(CanPickupComponent());
+            break;
+        case ItemKind::COMPASS:
+            item.addComponent(CanPickupComponent());
+            item.addComponent(CompassComponent());
+            break;
+        case ItemKind::BARRIER_SUIT:
+            item.addComponent(BarrierSuitComponent());
+            break;
+        case ItemKind::STAIRS:
+            item.addComponent(StairsComponent());
+            break;
+        default:
+            break;
+        }
+        itemBlueprints[kind] = item.id();
     }
 
-    player->addComponent(std::make_shared<DisplayComponent>('@'));
-    player->addComponent(std::make_shared<PositionComponent>(x, y));
-    player->addComponent(std::make_shared<PotionEffectComponent>(0, 0));
-    player->addComponent(std::make_shared<PlayerRaceComponent>(race));
-    player->addComponent(std::make_shared<GoldComponent>(0));
-    player->addComponent(std::make_shared<MoveableComponent>(true));
-    player->addComponent(std::make_shared<ActionComponent>());
-    player->addComponent(std::make_shared<DirectionComponent>());
+    // a hoard cannot be picked up until its dragon is slain
+    Entity hoard = blueprints->createEntity();
+    hoard.addComponent(ItemTypeComponent(ItemKind::TREASURE));
+    hoard.addComponent(DisplayComponent(traitsOf(ItemKind::TREASURE).display));
+    hoard.addComponent(TreasureComponent(0));
+    hoardBlueprint = hoard.id();
+}
+
+Entity SpawnSystem::spawnPlayer(EntityManager &entityManager, int x, int y, Race race)
+{
+    Entity player = entityManager.instantiate(*blueprints, raceBlueprints[std::size_t(race)]);
+    player.addComponent(PositionComponent(x, y));
     return player;
 }
 
-std::shared_ptr<Entity> SpawnSystem::spawnEnemy(EntityManager &entityManager, int x, int y, const std::string &enemyType, bool withCompass)
+Entity SpawnSystem::spawnEnemy(EntityManager &entityManager, int x, int y, EnemyKind enemyType, bool withCompass)
 {
-    auto enemy = entityManager.createEntity();
-    if (enemyType == "vampire")
-    {
-        enemy->addComponent(std::make_shared<DisplayComponent>('V'));
-        enemy->addComponent(std::make_shared<HealthComponent>(50));
-        enemy->addComponent(std::make_shared<AttackComponent>(25));
-        enemy->addComponent(std::make_shared<DefenseComponent>(25));
-        enemy->addComponent(std::make_shared<HostileComponent>());
-        enemy->addComponent(std::make_shared<GoldComponent>(1));
-    }
-    else if (enemyType == "werewolf")
-    {
-        enemy->addComponent(std::make_shared<DisplayComponent>('W'));
-        enemy->addComponent(std::make_shared<HealthComponent>(120));
-        enemy->addComponent(std::make_shared<AttackComponent>(30));
-        enemy->addComponent(std::make_shared<DefenseComponent>(5));
-        enemy->addComponent(std::make_shared<GoldComponent>(1));
-        enemy->addComponent(std::make_shared<HostileComponent>());
-    }
-    else if (enemyType == "troll")
-    {
-        enemy->addComponent(std::make_shared<DisplayComponent>('T'));
-        enemy->addComponent(std::make_shared<HealthComponent>(120));
-        enemy->addComponent(std::make_shared<AttackComponent>(25));
-        enemy->addComponent(std::make_shared<DefenseComponent>(15));
-        enemy->addComponent(std::make_shared<HostileComponent>());
-        enemy->addComponent(std::make_shared<GoldComponent>(1));
-    }
-    else if (enemyType == "goblin")
-    {
-        enemy->addComponent(std::make_shared<DisplayComponent>('N'));
-        enemy->addComponent(std::make_shared<HealthComponent>(70));
-        enemy->addComponent(std::make_shared<AttackComponent>(5));
-        enemy->addComponent(std::make_shared<DefenseComponent>(10));
-        enemy->addComponent(std::make_shared<HostileComponent>());
-        enemy->addComponent(std::make_shared<GoldComponent>(1));
-    }
-    else if (enemyType == "merchant")
-    {
-        enemy->addComponent(std::make_shared<DisplayComponent>('M'));
-        enemy->addComponent(std::make_shared<HealthComponent>(30));
-        enemy->addComponent(std::make_shared<AttackComponent>(70));
-        enemy->addComponent(std::make_shared<DefenseComponent>(5));
-        enemy->addComponent(std::make_shared<GoldComponent>(0));
-    }
-    else if (enemyType == "dragon")
-    {
-        enemy->addComponent(std::make_shared<DisplayComponent>('D'));
-        enemy->addComponent(std::make_shared<HealthComponent>(150));
-        enemy->addComponent(std::make_shared<AttackComponent>(20));
-        enemy->addComponent(std::make_shared<DefenseComponent>(20));
-        enemy->addComponent(std::make_shared<HostileComponent>());
-        enemy->addComponent(std::make_shared<GoldComponent>(0));
-    }
-    else if (enemyType == "phoenix")
-    {
-        enemy->addComponent(std::make_shared<DisplayComponent>('X'));
-        enemy->addComponent(std::make_shared<HealthComponent>(50));
-        enemy->addComponent(std::make_shared<HealthComponent>(50));
-        enemy->addComponent(std::make_shared<AttackComponent>(35));
-        enemy->addComponent(std::make_shared<DefenseComponent>(20));
-        enemy->addComponent(std::make_shared<HostileComponent>());
-        enemy->addComponent(std::make_shared<GoldComponent>(1));
-    }
-    // Add more enemy types as needed
-    enemy->addComponent(std::make_shared<MoveableComponent>(true));
-    enemy->addComponent(std::make_shared<EnemyTypeComponent>(enemyType));
-    enemy->addComponent(std::make_shared<PositionComponent>(x, y));
+    Entity enemy = entityManager.instantiate(*blueprints, enemyBlueprints[std::size_t(enemyType)]);
+    enemy.addComponent(PositionComponent(x, y));
     if (withCompass)
     {
-        enemy->addComponent(std::make_shared<CompassComponent>());
+        enemy.addComponent(CompassComponent());
     }
     return enemy;
 }
 
-std::shared_ptr<Entity> SpawnSystem::spawnPotion(EntityManager &entityManager, int x, int y, const std::string &potionType)
+Entity SpawnSystem::spawnPotion(EntityManager &entityManager, int x, int y, PotionKind potionType)
 {
-
-    auto potion = entityManager.createEntity();
-    potion->addComponent(std::make_shared<PositionComponent>(x, y));
-    potion->addComponent(std::make_shared<DisplayComponent>('P'));
-    potion->addComponent(std::make_shared<PotionTypeComponent>(potionType));
-    potion->addComponent(std::make_shared<CanPickupComponent>());
+    Entity potion = entityManager.instantiate(*blueprints, potionBlueprints[std::size_t(potionType)]);
+    potion.addComponent(PositionComponent(x, y));
     return potion;
 }
 
-std::shared_ptr<Entity> SpawnSystem::spawnTreasure(EntityManager &entityManager, int x, int y, const int &value)
+Entity SpawnSystem::spawnTreasure(EntityManager &entityManager, int x, int y, const int &value, bool hoard)
 {
-    auto treasure = entityManager.createEntity();
-    treasure->addComponent(std::make_shared<ItemTypeComponent>("treasure"));
-    treasure->addComponent(std::make_shared<PositionComponent>(x, y));
-    treasure->addComponent(std::make_shared<DisplayComponent>('G'));
-    treasure->addComponent(std::make_shared<TreasureComponent>(value));
-
-    if (value == 6) // Dragon hoard
-    {
-        // cannot pick up
-    }
-    else
-    {
-        treasure->addComponent(std::make_shared<CanPickupComponent>());
-    }
+    Entity treasure = entityManager.instantiate(*blueprints, hoard ? hoardBlueprint : itemBlueprints[std::size_t(ItemKind::TREASURE)]);
+    treasure.getComponent<TreasureComponent>()->value = value;
+    treasure.addComponent(PositionComponent(x, y));
     return treasure;
 }
 
-std::shared_ptr<Entity> SpawnSystem::spawnItem(EntityManager &entityManager, int x, int y, const std::string &itemType)
+Entity SpawnSystem::spawnItem(EntityManager &entityManager, int x, int y, ItemKind itemType)
 {
-    auto item = entityManager.createEntity();
-    item->addComponent(std::make_shared<PositionComponent>(x, y));
-    item->addComponent(std::make_shared<ItemTypeComponent>(itemType));
-    if (itemType == "compass")
-    {
-        item->addComponent(std::make_shared<DisplayComponent>('C'));
-        item->addComponent(std::make_shared<CanPickupComponent>());
-        item->addComponent(std::make_shared<CompassComponent>());
-    }
-    else if (itemType == "barrier_suit")
-    {
-        item->addComponent(std::make_shared<DisplayComponent>('B'));
-        item->addComponent(std::make_shared<BarrierSuitComponent>());
-    }
-    else if (itemType == "stairs")
-    {
-        item->addComponent(std::make_shared<DisplayComponent>('\\'));
-        item->addComponent(std::make_shared<StairsComponent>());
-    }
+    Entity item = entityManager.instantiate(*blueprints, itemBlueprints[std::size_t(itemType)]);
+    item.addComponent(PositionComponent(x, y));
     return item;
 }
 
-void SpawnSystem::update(std::vector<EntityManager> &entityManagers, int &floor, std::shared_ptr<Entity> &player)
+void SpawnSystem::update(EntityManager &entityManager, int &floor, Entity &player)
 {
-    EntityManager &entityManager = entityManagers.at(floor);
-
-    std::shared_ptr<ActionComponent> actionComponent = player->getComponent<ActionComponent>();
+    ActionComponent *actionComponent = player.getComponent<ActionComponent>();
     if (!actionComponent->move)
         return;
 
-    std::shared_ptr<PositionComponent> positionComponent = player->getComponent<PositionComponent>();
-    std::string &direction = player->getComponent<DirectionComponent>()->direction;
-    int row = positionComponent->row + DIRECTION_MAP.at(direction).first;
-    int col = positionComponent->col + DIRECTION_MAP.at(direction).second;
-    std::shared_ptr<Entity> entity = entityManager.getEntity(row, col);
+    PositionComponent *positionComponent = player.getComponent<PositionComponent>();
+    Direction direction = player.getComponent<DirectionComponent>()->direction;
+    int row = positionComponent->row + DIRECTION_ROW[std::size_t(direction)];
+    int col = positionComponent->col + DIRECTION_COL[std::size_t(direction)];
+    Entity entity = entityManager.getEntity(row, col);
 
     if (!entity)
     {
         return;
     }
 
-    std::shared_ptr<StairsComponent> stairsComponent = entity->getComponent<StairsComponent>();
+    StairsComponent *stairsComponent = entity.getComponent<StairsComponent>();
     if (!stairsComponent)
     {
         return;
     }
 
     // Move to next floor
-    moveToNextFloor(entityManagers, floor, player);
+    moveToNextFloor(entityManager, floor, player);
 }
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "systems/vision_system.h"
+#include "constants/constants.h"
+#include "entities/entity_manager.h"
+#include "components/components.h"
+#include "map/field_of_view.h"
+
+// far enough to see every corner of a board-sized view with the player in the middle of it,
+// and across any room of the board
+const int SIGHT_RADIUS = 41;
+
+void VisionSystem::reset()
+{
+    explored.clear();
+    visible = Bitboard();
+    floor = 0;
+}
+
+void VisionSystem::update(EntityManager &entityManager, Entity player, int currentFloor)
+{
+    if (!enabled)
+    {
+        return;
+    }
+
+    const FloorMap &map = entityManager.getMap();
+    floor = currentFloor;
+    if (static_cast<std::size_t>(floor) >= explored.size())
+    {
+        explored.resize(floor + 1);
+    }
+    Bitboard &seen = explored[floor];
+    if (seen.height() != map.getHeight() || seen.width() != map.getWidth())
+    {
+        seen = Bitboard(map.getHeight(), map.getWidth());
+    }
+    if (visible.height() != map.getHeight() || visible.width() != map.getWidth())
+    {
+        visible = Bitboard(map.getHeight(), map.getWidth());
+    }
+
+    // walls, and the void behind them, block the view; doors and passages do not
+    PositionComponent *position = player.getComponent<PositionComponent>();
+    visible.clearRows(lastRow - SIGHT_RADIUS, lastRow + SIGHT_RADIUS);
+    castFieldOfView(map.playerWalkable(), position->row, position->col, SIGHT_RADIUS, visible, seen);
+    lastRow = position->row;
+}
+
+void VisionSystem::setEnabled(bool enable)
+{
+    enabled = enable;
+}
+
+bool VisionSystem::isEnabled() const
+{
+    return enabled;
+}
+
+bool VisionSystem::isVisible(int row, int col) const
+{
+    return visible.test(row, col);
+}
+
+bool VisionSystem::isExplored(int row, int col) const
+{
+    return static_cast<std::size_t>(floor) < explored.size() && explored[floor].test(row, col);
+}
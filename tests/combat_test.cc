@@ -0,0 +1,60 @@
+#include <memory>
+#include <string>
+#include "test.h"
+#include "game/game.h"
+#include "map/floor_file.h"
+
+namespace
+{
+    std::shared_ptr<const FloorFile> floorOf(const std::string &text)
+    {
+        return std::make_shared<const FloorFile>(parseFloorFile(text.data(), text.size(), "test"));
+    }
+
+    // attacks east until the command is rejected, returns how many attacks were taken
+    int attackUntilRejected(Game &game)
+    {
+        for (int attacks = 0; attacks < 20; attacks++)
+        {
+            std::string input = "a ea";
+            try
+            {
+                game.turn(input);
+            }
+            catch (char const *e)
+            {
+                CHECK(std::string(e) == "Cannot attack that!");
+                return attacks;
+            }
+            game.getContext().actionMessage.clear();
+        }
+        return -1;
+    }
+}
+
+// A slain compass holder turns into the compass; attacking it again is rejected
+// instead of reading the enemy kind it no longer has.
+TEST(slainCompassHolderCannotBeAttacked)
+{
+    Game game(floorOf("|-----|\n|@N...|\n|-----|\n"), 1);
+    game.reset(Race::HUMAN, 1);
+    CHECK(attackUntilRejected(game) > 0);
+
+    Entity compass = game.currentFloor().getEntity(1, 2);
+    CHECK(compass && compass.hasComponent<ItemTypeComponent>());
+    CHECK(compass.getComponent<ItemTypeComponent>()->item_type == ItemKind::COMPASS);
+    CHECK(!compass.hasComponent<HealthComponent>());
+    CHECK(game.getPlayer().getComponent<HealthComponent>()->currentHealth > 0);
+}
+
+// likewise for the gold pile a slain merchant leaves behind
+TEST(slainMerchantCannotBeAttacked)
+{
+    Game game(floorOf("|-----|\n|@M...|\n|-----|\n"), 1);
+    game.reset(Race::HUMAN, 1);
+    CHECK(attackUntilRejected(game) > 0);
+
+    Entity gold = game.currentFloor().getEntity(1, 2);
+    CHECK(gold && gold.hasComponent<TreasureComponent>());
+    CHECK(!gold.hasComponent<HealthComponent>());
+}
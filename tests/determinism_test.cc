@@ -0,0 +1,108 @@
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "test.h"
+#include "game/game.h"
+#include "game/policy.h"
+#include "game/runner.h"
+#include "game/work_stealing_pool.h"
+
+namespace
+{
+    const int GAMES = 24;
+
+    struct Settings
+    {
+        bool prefetch;
+        bool chase;
+        int activeRadius;
+    };
+
+    void configure(Game &game, const Settings &settings)
+    {
+        game.setPrefetch(settings.prefetch);
+        game.setChase(settings.chase);
+        game.setActiveRadius(settings.activeRadius);
+    }
+
+    std::uint64_t play(Game &game, int seed)
+    {
+        RandomPolicy policy(seed);
+        playGame(game, policy, Race::HUMAN, seed);
+        return game.stateHash();
+    }
+
+    // the final state hash of games seeded 1 to GAMES, played one after another on one Game
+    std::vector<std::uint64_t> playInOrder(const Settings &settings)
+    {
+        Game game;
+        configure(game, settings);
+        std::vector<std::uint64_t> hashes;
+        for (int seed = 1; seed <= GAMES; seed++)
+        {
+            hashes.push_back(play(game, seed));
+        }
+        return hashes;
+    }
+
+    // the same games spread over a pool like the headless runner does, each worker reusing its Game
+    std::vector<std::uint64_t> playOnPool(const Settings &settings, unsigned threads)
+    {
+        WorkStealingPool pool(threads);
+        std::vector<std::unique_ptr<Game>> games;
+        for (unsigned worker = 0; worker < pool.size(); worker++)
+        {
+            games.emplace_back(new Game());
+            configure(*games.back(), settings);
+        }
+
+        std::vector<std::uint64_t> hashes(GAMES);
+        for (int i = 0; i < GAMES; i++)
+        {
+            pool.submit([&games, &hashes, i](unsigned worker)
+                        { hashes[i] = play(*games[worker], i + 1); });
+        }
+        pool.run();
+        return hashes;
+    }
+}
+
+// a seed decides the whole game, however often and on whichever Game it is played
+TEST(sameSeedSameGame)
+{
+    std::vector<std::uint64_t> first = playInOrder({true, false, 0});
+    CHECK(first == playInOrder({true, false, 0}));
+
+    // hashes tell games apart, so the comparisons above mean something
+    bool allSame = true;
+    for (std::uint64_t hash : first)
+    {
+        allSame = allSame && hash == first[0];
+    }
+    CHECK(!allSame);
+
+    // playing a seed on a fresh Game gives what it gave after other games on a used one
+    Game fresh;
+    CHECK(play(fresh, GAMES) == first.back());
+}
+
+// building floors in the background changes when they are built, not what they hold
+TEST(prefetchDoesNotChangeGames)
+{
+    CHECK(playInOrder({true, false, 0}) == playInOrder({false, false, 0}));
+    CHECK(playInOrder({true, true, 0}) == playInOrder({false, true, 0}));
+    CHECK(playInOrder({true, true, 4}) == playInOrder({false, true, 4}));
+}
+
+// the headless runner's thread count only changes which worker plays a game
+TEST(threadCountDoesNotChangeGames)
+{
+    for (Settings settings : {Settings{true, false, 0}, Settings{false, true, 6}})
+    {
+        std::vector<std::uint64_t> sequential = playInOrder(settings);
+        for (unsigned threads : {1u, 2u, 4u})
+        {
+            CHECK(playOnPool(settings, threads) == sequential);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+#include <cstdlib>
+#include <string>
+#include "test.h"
+#include "map/floor_file.h"
+
+namespace
+{
+    FloorFile parse(const std::string &text)
+    {
+        return parseFloorFile(text.data(), text.size(), "test");
+    }
+
+    // the message parseFloorFile rejects text with, empty if it is accepted
+    std::string rejection(const std::string &text)
+    {
+        try
+        {
+            parse(text);
+        }
+        catch (std::string e)
+        {
+            return e;
+        }
+        return "";
+    }
+
+    // every dragon of floor 0 guards a guardable spawn next to it, and no two guard the same one
+    bool guardsAreValid(const FloorFile &floors)
+    {
+        for (const FloorSpawn *dragon = floors.begin(0); dragon != floors.end(0); dragon++)
+        {
+            if (dragon->kind != FloorSpawn::ENEMY || dragon->type != std::uint8_t(EnemyKind::DRAGON))
+            {
+                continue;
+            }
+            if (std::abs(dragon->guardRow - dragon->row) > 1 || std::abs(dragon->guardCol - dragon->col) > 1)
+            {
+                return false;
+            }
+            int guarded = 0, sharing = 0;
+            for (const FloorSpawn *spawn = floors.begin(0); spawn != floors.end(0); spawn++)
+            {
+                guarded += spawn->row == dragon->guardRow && spawn->col == dragon->guardCol && spawn->kind == FloorSpawn::HOARD;
+                sharing += spawn->kind == FloorSpawn::ENEMY && spawn->type == dragon->type &&
+                           spawn->guardRow == dragon->guardRow && spawn->guardCol == dragon->guardCol;
+            }
+            if (guarded != 1 || sharing != 1)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+// Taking the first free hoard leaves the bottom dragon without one; the dragons above have
+// to move over to make room for it.
+TEST(dragonsShareOutCrowdedHoards)
+{
+    FloorFile floors = parse("|---------|\n"
+                             "|@.D.D....|\n"
+                             "|.9.9.9...|\n"
+                             "|..D......|\n"
+                             "|---------|\n");
+    CHECK(floors.count() == 1);
+    CHECK(guardsAreValid(floors));
+}
+
+// three dragons around two hoards cannot all guard one
+TEST(dragonsWithoutEnoughHoardsAreRejected)
+{
+    CHECK(rejection("|-------|\n"
+                    "|@.D.D..|\n"
+                    "|...9...|\n"
+                    "|..D9...|\n"
+                    "|-------|\n") == "test:2:6: dragon has no hoard or barrier suit of its own next to it");
+}
+
+// in a file with blank lines a row of wall as wide as the floor splits rooms, not floors
+TEST(floorsEndAtBlankLines)
+{
+    FloorFile floors = parse("|-----|\n"
+                             "|@....|\n"
+                             "|-----|\n"
+                             "|..9D.|\n"
+                             "|-----|\n"
+                             "\n"
+                             "\n"
+                             "|---|\n"
+                             "|.@.|\n"
+                             "|---|\n");
+    CHECK(floors.count() == 2);
+    CHECK(floors.getMap(0)->getHeight() == 5);
+    CHECK(floors.getMap(1)->getHeight() == 3);
+    CHECK(floors.getMap(1)->getWidth() == 5);
+    CHECK(floors.end(0) - floors.begin(0) == 3);
+    CHECK(floors.end(1) - floors.begin(1) == 1);
+}
+
+// the stock cc3kfloor.txt puts its floors back to back, each ending where its top wall repeats
+TEST(stockFloorFileParses)
+{
+    FloorFile floors = loadFloorFile("cc3kfloor.txt");
+    CHECK(floors.count() == 5);
+    for (int floor = 0; floor < floors.count(); floor++)
+    {
+        CHECK(floors.getMap(floor) == boardMap());
+        int players = 0;
+        for (const FloorSpawn *spawn = floors.begin(floor); spawn != floors.end(floor); spawn++)
+        {
+            players += spawn->kind == FloorSpawn::PLAYER;
+        }
+        CHECK(players == 1);
+    }
+}
+
+TEST(backToBackFloorsEndAtTheirTopWall)
+{
+    FloorFile floors = parse("|-----|\n"
+                             "|@....|\n"
+                             "|-----|\n"
+                             "|---|\n"
+                             "|.@.|\n"
+                             "|---|\n");
+    CHECK(floors.count() == 2);
+    CHECK(floors.getMap(0)->getHeight() == 3);
+    CHECK(floors.getMap(1)->getWidth() == 5);
+    CHECK(rejection("|---|\n|.@.|\n|...|\n") == "test:4:1: file ends before the bottom wall of floor 1");
+}
+
+TEST(entitiesStayOffTheOuterWalls)
+{
+    CHECK(rejection("|---|\n|.@.|\n|.V.|\n\n|---|\n|.@.|\n|---|\n") == "test:3:3: 'V' in the bottom wall");
+    CHECK(rejection("|-@-|\n|...|\n|---|\n") == "test:1:3: '@' in the top wall");
+    CHECK(rejection("|---|\n@...|\n|---|\n") == "test:2:1: '@' in the left wall");
+    CHECK(rejection("|---|\n|.@.|\n|...V\n|---|\n") == "test:3:5: 'V' in the right wall");
+    CHECK(rejection("|-----|\n|@....|\n\n|---|\n|.@.|\n|---|\n") == "test:1:1: floor 1 needs a top wall, a bottom wall and a row in between");
+    CHECK(rejection("|---|\n|---|\n") == "test:1:1: floor 1 needs a top wall, a bottom wall and a row in between");
+}
@@ -0,0 +1,87 @@
+#include <string>
+#include "test.h"
+#include "constants/game_data.h"
+
+namespace
+{
+    // complete data, one definition per line, with the line starting with prefix swapped for replacement
+    std::string dataWith(const std::string &prefix, const std::string &replacement)
+    {
+        const char *const lines[] = {
+            "race human 140 20 20 1 1.5 0", // line 1
+            "race dwarf 100 20 30 2 1 0",
+            "race elf 140 30 10 1 1 1",
+            "race orc 180 30 25 0.5 1 0",
+            "enemy vampire V 50 25 25 1 1", // line 5
+            "enemy werewolf W 120 30 5 1 1",
+            "enemy troll T 120 25 15 1 1",
+            "enemy goblin N 70 5 10 1 1",
+            "enemy merchant M 30 70 5 0 0",
+            "enemy dragon D 150 20 20 0 1",
+            "enemy phoenix X 50 35 20 1 1",
+            "potion RH 10 0 0 RH",
+            "potion BA 0 5 0 BA",
+            "potion BD 0 0 5 BD",
+            "potion PH -10 0 0 RH",
+            "potion WA 0 -5 0 BA",
+            "potion WD 0 0 -5 BD",
+            "spawn goblin 1",
+            "treasure 1 1 0",
+        };
+        std::string text;
+        for (std::string line : lines)
+        {
+            text += (line.compare(0, prefix.size(), prefix) == 0 ? replacement : line) + '\n';
+        }
+        return text;
+    }
+
+    // the message parseGameData rejects text with, empty if it is accepted
+    std::string rejection(const std::string &text)
+    {
+        try
+        {
+            parseGameData(text, "test");
+        }
+        catch (std::string e)
+        {
+            return e;
+        }
+        return "";
+    }
+}
+
+TEST(gameDataAcceptsStockValues)
+{
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire V 50 25 25 1 1")) == "");
+    // potions may take stats away, defense and gold may be zero
+    CHECK(rejection(dataWith("enemy troll", "enemy troll T 120 25 0 0 1")) == "");
+    CHECK(rejection(dataWith("enemy troll", "enemy troll Q 120 25 15 1 1")) == "");
+    // the human score bonus is data like the rest of a race
+    CHECK(traitsOf(Race::HUMAN).scoreMultiplier == 1.5f);
+    CHECK(parseGameData(dataWith("race human", "race human 140 20 20 1 2 0"), "test").races[std::size_t(Race::HUMAN)].scoreMultiplier == 2);
+}
+
+TEST(gameDataRejectsClashingEnemyGlyphs)
+{
+    CHECK(rejection(dataWith("enemy werewolf", "enemy werewolf V 50 25 25 1 1")) == "test:6: glyph V is already used by the vampire");
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire @ 50 25 25 1 1")) == "test:5: glyph @ is used by the player");
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire P 50 25 25 1 1")) == "test:5: glyph P is used by the potions");
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire G 50 25 25 1 1")) == "test:5: glyph G is used by the treasure");
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire \\ 50 25 25 1 1")) == "test:5: glyph \\ is used by the stairs");
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire 7 50 25 25 1 1")) == "test:5: glyph 7 is part of the floor file format");
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire . 50 25 25 1 1")) == "test:5: glyph . is part of the floor file format");
+}
+
+TEST(gameDataRejectsNonPositiveStats)
+{
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire V 0 25 25 1 1")) == "test:5: health and attack have to be positive");
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire V 50 -3 25 1 1")) == "test:5: health and attack have to be positive");
+    CHECK(rejection(dataWith("enemy vampire", "enemy vampire V 50 25 -1 1 1")) == "test:5: defense and gold cannot be negative");
+    CHECK(rejection(dataWith("race orc", "race orc 0 30 25 0.5 1 0")) == "test:4: health, attack and the gold and score multipliers have to be positive");
+    CHECK(rejection(dataWith("race orc", "race orc 180 30 25 0 1 0")) == "test:4: health, attack and the gold and score multipliers have to be positive");
+    CHECK(rejection(dataWith("race orc", "race orc 180 30 25 -0.5 1 0")) == "test:4: health, attack and the gold and score multipliers have to be positive");
+    CHECK(rejection(dataWith("race orc", "race orc 180 30 25 0.5 0 0")) == "test:4: health, attack and the gold and score multipliers have to be positive");
+    // a malformed line is reported as such, not as a bad value
+    CHECK(rejection(dataWith("race orc", "race orc 180 x 25 1 0")) == "test:4: race has missing or malformed fields");
+}
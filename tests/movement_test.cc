@@ -0,0 +1,112 @@
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include "test.h"
+#include "game/game.h"
+#include "game/policy.h"
+#include "map/floor_file.h"
+
+namespace
+{
+    std::shared_ptr<const FloorFile> floorOf(const std::string &text)
+    {
+        return std::make_shared<const FloorFile>(parseFloorFile(text.data(), text.size(), "test"));
+    }
+
+    // runs input, returns false if the pipeline rejected it
+    bool tryTurn(Game &game, std::string input)
+    {
+        bool accepted = true;
+        try
+        {
+            game.turn(input);
+        }
+        catch (char const *e)
+        {
+            accepted = false;
+        }
+        catch (std::string e)
+        {
+            accepted = false;
+        }
+        game.getContext().actionMessage.clear();
+        return accepted;
+    }
+
+    // where every enemy of the current floor stands, by id
+    std::map<EntityId, std::pair<int, int>> enemyPositions(Game &game)
+    {
+        std::map<EntityId, std::pair<int, int>> positions;
+        game.currentFloor().forEach<EnemyTypeComponent, PositionComponent>([&positions](Entity e, EnemyTypeComponent &, PositionComponent &position)
+                                                                            { positions[e.id()] = std::make_pair(position.row, position.col); });
+        return positions;
+    }
+}
+
+// Walking into the wall is rejected and is not a turn, so enemies asleep outside the active
+// radius have no more to catch up on than if it had never been typed.
+TEST(rejectedMovesDoNotWakeEnemiesEarly)
+{
+    const std::string corridor = "|----------------------------|\n"
+                                 "|@.........NWTNX.............|\n"
+                                 "|----------------------------|\n";
+    std::uint64_t hashes[2];
+    for (bool rejections : {false, true})
+    {
+        Game game(floorOf(corridor), 1);
+        game.setActiveRadius(10);
+        game.reset(Race::HUMAN, 7);
+        for (int step = 0; step < 60; step++)
+        {
+            // the corridor is one row, north is always the wall
+            if (rejections)
+            {
+                CHECK(!tryTurn(game, "no"));
+                CHECK(!tryTurn(game, "no"));
+            }
+            // back and forth, so enemies at the edge of the radius keep falling asleep and waking up
+            tryTurn(game, step % 4 < 2 ? "ea" : "we");
+        }
+        hashes[rejections] = game.stateHash();
+    }
+    CHECK(hashes[0] == hashes[1]);
+}
+
+// An enemy next to the player once it has moved stays put that turn, also when it was asleep
+// and has turns to catch up on.
+TEST(enemiesNextToThePlayerDoNotMove)
+{
+    for (int radius : {1, 2, 3})
+    {
+        for (int seed = 1; seed <= 40; seed++)
+        {
+            Game game;
+            game.setActiveRadius(radius);
+            game.reset(Race::HUMAN, seed);
+            RandomPolicy policy(seed);
+            for (int commands = 0; commands < 400 && !game.isOver(); commands++)
+            {
+                int floor = game.getFloor();
+                std::map<EntityId, std::pair<int, int>> before = enemyPositions(game);
+                if (!tryTurn(game, policy.nextCommand(game)) || game.isOver() || game.getFloor() != floor)
+                {
+                    continue;
+                }
+
+                PositionComponent *player = game.getPlayer().getComponent<PositionComponent>();
+                for (const auto &after : enemyPositions(game))
+                {
+                    auto was = before.find(after.first);
+                    if (was != before.end() && std::abs(was->second.first - player->row) <= 1 &&
+                        std::abs(was->second.second - player->col) <= 1)
+                    {
+                        CHECK(was->second == after.second);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,107 @@
+#include <utility>
+#include <vector>
+#include "test.h"
+#include "components/components.h"
+#include "entities/entity_manager.h"
+#include "game/floor_cache.h"
+#include "systems/spawn_system.h"
+
+namespace
+{
+    // the owners of every component T in the order forEach visits them, with one value of each
+    template <typename T, typename Value>
+    std::vector<std::pair<EntityId, Value>> visits(EntityManager &floor, Value (*value)(const T &))
+    {
+        std::vector<std::pair<EntityId, Value>> seen;
+        floor.forEach<T>([&seen, value](Entity entity, T &component)
+                         { seen.emplace_back(entity.id(), value(component)); });
+        return seen;
+    }
+
+    int cell(const PositionComponent &position) { return position.row * 1000 + position.col; }
+    int health(const HealthComponent &component) { return component.currentHealth; }
+    float gold(const GoldComponent &component) { return component.gold; }
+    char glyph(const DisplayComponent &component) { return component.display_char; }
+
+    // both floors hold the same entities and components, in the same order
+    bool sameFloor(EntityManager &floor, EntityManager &other)
+    {
+        if (&floor.getMap() != &other.getMap() || floor.getEntities() != other.getEntities())
+        {
+            return false;
+        }
+        for (int row = 0; row < floor.getMap().getHeight(); row++)
+        {
+            for (int col = 0; col < floor.getMap().getWidth(); col++)
+            {
+                if (floor.getEntity(row, col).id() != other.getEntity(row, col).id())
+                {
+                    return false;
+                }
+            }
+        }
+        return visits(floor, cell) == visits(other, cell) && visits(floor, health) == visits(other, health) &&
+               visits(floor, gold) == visits(other, gold) && visits(floor, glyph) == visits(other, glyph);
+    }
+}
+
+// A generated floor paged out and into a manager holding another floor comes back the same,
+// down to the order of its pools and of the entities stacked on a cell, and hands out the same
+// ids afterwards.
+TEST(pagedFloorsRoundTrip)
+{
+    SpawnSystem spawnSystem;
+    for (int seed = 1; seed <= 20; seed++)
+    {
+        EntityManager floor;
+        spawnSystem.newFloor(floor, seed, seed % 5 == 0, Race::HUMAN);
+        // a second entity under the player, and a gap in the ids
+        Entity player;
+        floor.forEach<PlayerRaceComponent>([&player](Entity entity, PlayerRaceComponent &)
+                                           { player = entity; });
+        const PositionComponent under = *player.getComponent<PositionComponent>();
+        Entity stacked = floor.createEntity();
+        stacked.addComponent(DisplayComponent('?'));
+        floor.setPosition(stacked, under.row, under.col);
+        floor.removeEntity(Entity{&floor, floor.getEntities()[1]});
+
+        FloorPage page;
+        floor.pageOut(page);
+        EntityManager restored;
+        spawnSystem.newFloor(restored, seed + 100, false, Race::ELF);
+        restored.pageIn(page);
+        CHECK(restored.validateSpatialIndex());
+        CHECK(sameFloor(floor, restored));
+
+        floor.removeEntity(player);
+        restored.removeEntity(Entity{&restored, player.id()});
+        CHECK(restored.getEntity(under.row, under.col).id() == stacked.id());
+        CHECK(restored.createEntity().id() == floor.createEntity().id());
+        CHECK(sameFloor(floor, restored));
+    }
+}
+
+// the cache hands back what was stored for a seed and race, and forgets it for any other
+TEST(floorCacheKeepsOneSeedAndRace)
+{
+    SpawnSystem spawnSystem;
+    EntityManager floor;
+    spawnSystem.newFloor(floor, 7, false, Race::HUMAN);
+    FloorCache cache;
+    cache.use(7, Race::HUMAN, 5);
+    CHECK(!cache.find(2));
+    cache.store(2, floor);
+    CHECK(cache.find(2) && !cache.find(1));
+
+    EntityManager restored;
+    restored.pageIn(*cache.find(2));
+    CHECK(sameFloor(floor, restored));
+
+    cache.use(7, Race::HUMAN, 5);
+    CHECK(cache.find(2));
+    cache.use(7, Race::ELF, 5);
+    CHECK(!cache.find(2));
+    cache.store(2, floor);
+    cache.use(8, Race::ELF, 5);
+    CHECK(!cache.find(2));
+}
@@ -0,0 +1,116 @@
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include "test.h"
+#include "constants/game_data.h"
+#include "game/game.h"
+#include "game/policy.h"
+#include "game/replay.h"
+#include "map/floor_file.h"
+
+namespace
+{
+    // a fresh file for the test to write, removed when it goes out of scope
+    struct TemporaryFile
+    {
+        std::string path;
+
+        TemporaryFile()
+        {
+            char name[] = "/tmp/cc3k-test-XXXXXX";
+            int fd = mkstemp(name);
+            if (fd >= 0)
+            {
+                close(fd);
+            }
+            path = name;
+        }
+        ~TemporaryFile() { std::remove(path.c_str()); }
+    };
+
+    // plays up to commands random commands the way the interactive loop does, recording them
+    std::uint64_t recordSession(const std::string &path, const SessionSettings &settings, int commands)
+    {
+        Game game(nullptr, settings.floors);
+        game.setChase(settings.chase);
+        game.setActiveRadius(settings.activeRadius);
+        Recorder recorder(path, settings);
+        recorder.newGame(Race::ELF);
+        game.reset(Race::ELF, settings.seed);
+
+        RandomPolicy policy(settings.seed);
+        for (int i = 0; i < commands && !game.isOver(); i++)
+        {
+            std::string input = policy.nextCommand(game);
+            recorder.command(input);
+            try
+            {
+                game.turn(input);
+            }
+            catch (char const *e)
+            {
+            }
+            catch (std::string e)
+            {
+            }
+            game.getContext().actionMessage.clear();
+        }
+        recorder.finish(game.stateHash());
+        return game.stateHash();
+    }
+}
+
+// the floor count, chase and active radius come from the log, not from the replaying command line
+TEST(replayUsesTheRecordedSettings)
+{
+    TemporaryFile log;
+    SessionSettings settings;
+    settings.seed = 11;
+    settings.floors = 3;
+    settings.chase = true;
+    settings.activeRadius = 4;
+    settings.dataHash = gameData().hash;
+    std::uint64_t hash = recordSession(log.path, settings, 300);
+
+    ReplayResult result = replay(log.path, nullptr);
+    CHECK(result.games == 1);
+    CHECK(result.commands > 0);
+    CHECK(result.recordedHash == hash);
+    CHECK(result.matches());
+}
+
+TEST(replayRejectsOtherInputs)
+{
+    TemporaryFile log;
+    SessionSettings settings;
+    settings.dataHash = gameData().hash;
+    recordSession(log.path, settings, 10);
+
+    const std::string text = "|---|\n|.@.|\n|---|\n";
+    std::shared_ptr<const FloorFile> floors = std::make_shared<const FloorFile>(parseFloorFile(text.data(), text.size(), "test"));
+    bool rejected = false;
+    try
+    {
+        replay(log.path, floors);
+    }
+    catch (std::string e)
+    {
+        rejected = true;
+    }
+    CHECK(rejected);
+
+    TemporaryFile otherData;
+    settings.dataHash = gameData().hash + 1;
+    recordSession(otherData.path, settings, 10);
+    rejected = false;
+    try
+    {
+        replay(otherData.path, nullptr);
+    }
+    catch (std::string e)
+    {
+        rejected = true;
+    }
+    CHECK(rejected);
+}
@@ -0,0 +1,41 @@
+#include <string>
+#include <utility>
+#include <vector>
+#include "test.h"
+#include "map/floor_map.h"
+#include "map/rooms.h"
+
+// two rooms joined by a door and a passage, which belong to neither, and an entity glyph that
+// counts as the floor under it
+TEST(findRoomsSplitsAtDoorsAndPassages)
+{
+    RoomTable rooms = findRooms({"|-----|     |---|",
+                                 "|.@...+#####+...|",
+                                 "|.....|     |.V.|",
+                                 "|-----|     |---|"});
+    CHECK(rooms.count() == 2);
+    CHECK(rooms.size(0) == 10);
+    CHECK(rooms.size(1) == 6);
+    // numbered by their first cell, and each room's cells in row-major order
+    CHECK(rooms.cell(0, 0) == std::make_pair(1, 1));
+    CHECK(rooms.cell(0, 1) == std::make_pair(1, 2));
+    CHECK(rooms.cell(0, 9) == std::make_pair(2, 5));
+    CHECK(rooms.cell(1, 0) == std::make_pair(1, 13));
+    CHECK(rooms.cell(1, 5) == std::make_pair(2, 15));
+}
+
+// a map from a floor file has the rooms of its own layout, not those of the stock board
+TEST(floorMapsFindTheirOwnRooms)
+{
+    FloorMap map({"|---|---|",
+                  "|...|...|",
+                  "|---|...|",
+                  "|...|...|",
+                  "|---|---|"});
+    CHECK(map.rooms().count() == 3);
+    CHECK(map.rooms().size(0) == 3);
+    CHECK(map.rooms().size(1) == 9);
+    CHECK(map.rooms().size(2) == 3);
+    CHECK(&map.rooms() == &map.rooms());
+    CHECK(boardMap()->rooms().count() == 5);
+}
@@ -0,0 +1,35 @@
+#include "test.h"
+#include "entities/storage_allocator.h"
+#include "game/game.h"
+#include "game/policy.h"
+#include "game/runner.h"
+
+// Once every pool of a Game has grown to fit a floor, playing more games reuses the storage:
+// generating new floors and spawning into them takes no new blocks.
+TEST(storageIsReusedAfterWarmUp)
+{
+    for (bool prefetch : {true, false})
+    {
+        Game game;
+        game.setPrefetch(prefetch);
+        for (int seed = 100; seed < 105; seed++)
+        {
+            RandomPolicy policy(seed);
+            playGame(game, policy, Race::HUMAN, seed);
+        }
+
+        std::size_t allocations = StorageStats::allocations();
+        CHECK(allocations > 0);
+        int turns = 0, floors = 0;
+        for (int seed = 1; seed <= 20; seed++)
+        {
+            RandomPolicy policy(seed);
+            playGame(game, policy, Race::HUMAN, seed);
+            turns += game.getStats().turns;
+            floors += game.getStats().floor;
+        }
+        CHECK(turns > 1000);
+        CHECK(floors > 20);
+        CHECK(StorageStats::allocations() == allocations);
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef TEST_H
+#define TEST_H
+
+// A minimal test registry. TEST(name) defines a case that test_main.cc runs; CHECK(condition)
+// records a failure and carries on, so one run reports every broken check.
+
+struct TestRegistrar
+{
+    TestRegistrar(const char *name, void (*run)());
+};
+
+void checkFailed(const char *file, int line, const char *expression);
+
+#define TEST(name)                                            \
+    static void name();                                       \
+    static TestRegistrar name##Registrar(#name, name);        \
+    static void name()
+
+#define CHECK(condition)                                      \
+    do                                                        \
+    {                                                         \
+        if (!(condition))                                     \
+        {                                                     \
+            checkFailed(__FILE__, __LINE__, #condition);      \
+        }                                                     \
+    } while (false)
+
+#endif // TEST_H
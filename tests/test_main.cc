@@ -0,0 +1,78 @@
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "test.h"
+
+namespace
+{
+    struct TestCase
+    {
+        const char *name;
+        void (*run)();
+    };
+
+    // a function-local static so registrars in other files can run first
+    std::vector<TestCase> &testCases()
+    {
+        static std::vector<TestCase> cases;
+        return cases;
+    }
+
+    int failedChecks = 0;
+}
+
+TestRegistrar::TestRegistrar(const char *name, void (*run)())
+{
+    testCases().push_back({name, run});
+}
+
+void checkFailed(const char *file, int line, const char *expression)
+{
+    std::cout << file << ':' << line << ": CHECK(" << expression << ") failed\n";
+    failedChecks++;
+}
+
+// Runs every test, or only the ones named on the command line
+int main(int argc, char *argv[])
+{
+    int failedTests = 0, ran = 0;
+    for (const TestCase &test : testCases())
+    {
+        bool selected = argc == 1;
+        for (int i = 1; i < argc; i++)
+        {
+            selected = selected || std::strcmp(argv[i], test.name) == 0;
+        }
+        if (!selected)
+        {
+            continue;
+        }
+
+        int failedBefore = failedChecks;
+        try
+        {
+            test.run();
+        }
+        catch (std::string e)
+        {
+            checkFailed(test.name, 0, ("threw " + e).c_str());
+        }
+        catch (char const *e)
+        {
+            checkFailed(test.name, 0, (std::string("threw ") + e).c_str());
+        }
+        catch (std::exception &e)
+        {
+            checkFailed(test.name, 0, (std::string("threw ") + e.what()).c_str());
+        }
+        bool passed = failedChecks == failedBefore;
+        std::cout << (passed ? "PASS " : "FAIL ") << test.name << std::endl;
+        failedTests += !passed;
+        ran++;
+    }
+
+    std::cout << ran - failedTests << " of " << ran << " tests passed" << std::endl;
+    return failedTests ? 1 : 0;
+}